@@ -2,14 +2,28 @@
 #include "vector_assert.cpp"
 #include "linked_list_assert.cpp"
 #include "hash_table_assert.cpp"
+#include "hash_table_view_assert.cpp"
+#include "string_hash_table_assert.cpp"
+#include "flat_hash_table_assert.cpp"
+#include "concurrent_hash_table_assert.cpp"
+#include "sharded_aggregator_assert.cpp"
 #include "search_tree_assert.cpp"
+#include "bplus_tree_assert.cpp"
+#include "concurrent_bplus_tree_assert.cpp"
 
 int main(int argc, char *argv[]) {
 	test_array();
 	test_vector();
 	test_list();
 	test_table();
+	test_table_view();
+	test_string_table();
+	test_flat_table();
+	test_concurrent_table();
+	test_aggregator();
 	test_tree();
+	test_bplus_tree();
+	test_concurrent_bplus_tree();
 
 	return 0;
 }
\ No newline at end of file
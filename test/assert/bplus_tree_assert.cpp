@@ -0,0 +1,868 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <map>
+#include <random>
+#include "../../tfds/tf_bplus_tree.hpp"
+
+// throws when it is copied after copies_left more copies (never if copies_left is negative)
+struct bplus_tree_assert_throwing_value {
+	static int copies_left;
+
+	bplus_tree_assert_throwing_value() {}
+
+	bplus_tree_assert_throwing_value(const bplus_tree_assert_throwing_value &) {
+		count_copy();
+	}
+
+	bplus_tree_assert_throwing_value &operator=(const bplus_tree_assert_throwing_value &) {
+		count_copy();
+		return *this;
+	}
+
+	static void count_copy() {
+		if (copies_left == 0)
+			throw tf::exception("throwing value: copy");
+		if (copies_left > 0)
+			--copies_left;
+	}
+};
+
+int bplus_tree_assert_throwing_value::copies_left = -1;
+
+void test_bplus_tree();
+void test_bplus_tree_default_constructor();
+void test_bplus_tree_insert();
+void test_bplus_tree_get();
+void test_bplus_tree_copy_constructor();
+void test_bplus_tree_swap();
+void test_bplus_tree_move_constructor();
+void test_bplus_tree_copy_assignment();
+void test_bplus_tree_brackets_operator();
+void test_bplus_tree_min();
+void test_bplus_tree_max();
+void test_bplus_tree_pop_min();
+void test_bplus_tree_pop_max();
+void test_bplus_tree_contains();
+void test_bplus_tree_remove();
+void test_bplus_tree_iteration();
+void test_bplus_tree_empty();
+void test_bplus_tree_clear();
+void test_bplus_tree_lookup_key();
+void test_bplus_tree_find();
+void test_bplus_tree_bounds();
+void test_bplus_tree_range();
+void test_bplus_tree_random_operations();
+
+
+/* int main(int argc, char *argv[]) {
+	test_bplus_tree();
+
+	return 0;
+} */
+
+void test_bplus_tree() {
+	test_bplus_tree_default_constructor();
+	test_bplus_tree_insert();
+	test_bplus_tree_get();
+	test_bplus_tree_copy_constructor();
+	test_bplus_tree_swap();
+	test_bplus_tree_move_constructor();
+	test_bplus_tree_copy_assignment();
+	test_bplus_tree_brackets_operator();
+	test_bplus_tree_min();
+	test_bplus_tree_max();
+	test_bplus_tree_pop_min();
+	test_bplus_tree_pop_max();
+	test_bplus_tree_contains();
+	test_bplus_tree_remove();
+	test_bplus_tree_iteration();
+	test_bplus_tree_empty();
+	test_bplus_tree_clear();
+	test_bplus_tree_lookup_key();
+	test_bplus_tree_find();
+	test_bplus_tree_bounds();
+	test_bplus_tree_range();
+	test_bplus_tree_random_operations();
+
+	std::cout << "B+ TREE tests successful." << std::endl;
+}
+
+// prec: -
+void test_bplus_tree_default_constructor() {
+	tf::bplus_tree<int, std::string> t;
+	assert(t.size() == 0);
+	assert(t.height() == 0);
+	assert(t.empty() == true);
+}
+
+// prec: default_constructor
+void test_bplus_tree_insert() {
+	tf::bplus_tree<int, std::string> t;
+
+	// -- //
+
+	t.insert(2, "Two");
+	assert(t.size() == 1);
+	assert(t.height() == 1);
+
+	t.insert(6, "Six");
+	t.insert(-2, "nTwo");
+	assert(t.size() == 3);
+	assert(t.height() == 1);
+
+	try {
+		t.insert(2, "Two2");
+		assert(false);
+	} catch (tf::exception &) {}
+	assert(t.size() == 3);
+
+	// leaves and inner nodes are split
+	for (int i = 0; i < 10000; ++i) {
+		if (i != 2 && i != 6)
+			t.insert(i, std::to_string(i));
+	}
+	assert(t.size() == 10001);
+	assert(t.height() > 2);
+}
+
+// prec: insert
+void test_bplus_tree_get() {
+	tf::bplus_tree<int, std::string> t;
+
+	// -- //
+
+	t.insert(2, "Two");
+	assert(t.get(2) == "Two");
+
+	t.insert(6, "Six");
+	t.insert(-6, "nSix");
+	assert(t.get(2) == "Two");
+	assert(t.get(6) == "Six");
+	assert(t.get(-6) == "nSix");
+
+	for (int i = 100; i < 5000; ++i) {
+		t.insert(i, std::to_string(i));
+	}
+
+	for (int i = 100; i < 5000; ++i) {
+		assert(t.get(i) == std::to_string(i));
+	}
+	assert(t.get(-6) == "nSix");
+
+	try {
+		t.get(1);
+		assert(false);
+	} catch (tf::exception &) {}
+
+	try {
+		t.get(5000);
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: get
+void test_bplus_tree_copy_constructor() {
+	tf::bplus_tree<int, std::string> t;
+	for (int i = 0; i < 1000; ++i) {
+		t.insert(i, std::to_string(i));
+	}
+
+	// -- //
+
+	tf::bplus_tree<int, std::string> t2(t);
+	assert(t2.size() == 1000);
+
+	for (int i = 0; i < 1000; ++i) {
+		assert(t2.get(i) == std::to_string(i));
+	}
+
+	t.remove(1);
+	assert(t2.contains(1) == true);
+
+	// -- //
+
+	// the copy has the shape of the original and its own linked leaves
+	tf::bplus_tree<int, std::string> t3(t2);
+	assert(t3.size() == 1000);
+	assert(t3.height() == t2.height());
+	assert(t3.min() == "0" && t3.max() == "999");
+
+	int expected = 999;
+	for (auto it = t3.end(); it.has_value(); --it) {
+		assert(it.key() == expected--);
+	}
+	assert(expected == -1);
+
+	t3.insert(1000, "1000");
+	t3.remove(0);
+	assert(t2.contains(0) == true && t2.contains(1000) == false);
+
+	tf::bplus_tree<int, std::string> empty;
+	tf::bplus_tree<int, std::string> empty_copy(empty);
+	assert(empty_copy.empty() == true && empty_copy.height() == 0);
+
+	// a value that throws while it is copied leaves nothing behind
+	tf::bplus_tree<int, bplus_tree_assert_throwing_value> throwing;
+	for (int i = 0; i < 1000; ++i) {
+		throwing.insert(i, bplus_tree_assert_throwing_value());
+	}
+
+	bplus_tree_assert_throwing_value::copies_left = 500;
+	bool thrown = false;
+	try {
+		tf::bplus_tree<int, bplus_tree_assert_throwing_value> throwing_copy(throwing);
+	}
+	catch (tf::exception &e) {
+		thrown = true;
+	}
+	assert(thrown);
+	bplus_tree_assert_throwing_value::copies_left = -1;
+}
+
+// prec: get
+void test_bplus_tree_swap() {
+	tf::bplus_tree<int, std::string> t;
+	t.insert(1, "One");
+	t.insert(2, "Two");
+
+	tf::bplus_tree<int, std::string> t2;
+	t2.insert(3, "Three");
+
+	// -- //
+
+	swap(t, t2);
+	assert(t.size() == 1);
+	assert(t.get(3) == "Three");
+	assert(t2.size() == 2);
+	assert(t2.get(1) == "One");
+	assert(t2.get(2) == "Two");
+}
+
+// prec: get
+void test_bplus_tree_move_constructor() {
+	tf::bplus_tree<int, std::string> t;
+	t.insert(1, "One");
+	t.insert(2, "Two");
+
+	// -- //
+
+	tf::bplus_tree<int, std::string> t2(std::move(t));
+	assert(t2.size() == 2);
+	assert(t2.get(1) == "One");
+	assert(t2.get(2) == "Two");
+}
+
+// prec: get
+void test_bplus_tree_copy_assignment() {
+	tf::bplus_tree<int, std::string> t;
+	t.insert(1, "One");
+	t.insert(2, "Two");
+
+	tf::bplus_tree<int, std::string> t2;
+	t2.insert(3, "Three");
+
+	// -- //
+
+	t2 = t;
+	assert(t2.size() == 2);
+	assert(t2.get(1) == "One");
+	assert(t2.get(2) == "Two");
+	assert(t2.contains(3) == false);
+
+	t.insert(3, "Three");
+	assert(t2.contains(3) == false);
+}
+
+// prec: insert
+void test_bplus_tree_brackets_operator() {
+	tf::bplus_tree<int, std::string> t;
+	t.insert(1, "One");
+
+	// -- //
+
+	assert(t[1] == "One");
+	t[1] = "New One";
+	assert(t.get(1) == "New One");
+
+	const tf::bplus_tree<int, std::string> &const_t = t;
+	assert(const_t[1] == "New One");
+
+	try {
+		t[2];
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: insert
+void test_bplus_tree_min() {
+	tf::bplus_tree<int, std::string> t;
+
+	// -- //
+
+	try {
+		t.min();
+		assert(false);
+	} catch (tf::exception &) {}
+
+	t.insert(5, "Five");
+	assert(t.min() == "Five");
+
+	t.insert(1, "One");
+	assert(t.min() == "One");
+
+	for (int i = 10; i < 1000; ++i) {
+		t.insert(i, std::to_string(i));
+	}
+	assert(t.min() == "One");
+
+	t.insert(-1, "nOne");
+	assert(t.min() == "nOne");
+}
+
+// prec: insert
+void test_bplus_tree_max() {
+	tf::bplus_tree<int, std::string> t;
+
+	// -- //
+
+	try {
+		t.max();
+		assert(false);
+	} catch (tf::exception &) {}
+
+	t.insert(5, "Five");
+	assert(t.max() == "Five");
+
+	for (int i = -1000; i < 0; ++i) {
+		t.insert(i, std::to_string(i));
+	}
+	assert(t.max() == "Five");
+
+	t.insert(6, "Six");
+	assert(t.max() == "Six");
+}
+
+// prec: insert
+void test_bplus_tree_pop_min() {
+	tf::bplus_tree<int, std::string> t;
+	for (int i = 999; i >= 0; --i) {
+		t.insert(i, std::to_string(i));
+	}
+
+	// -- //
+
+	for (int i = 0; i < 1000; ++i) {
+		assert(t.pop_min() == std::to_string(i));
+		assert(t.size() == static_cast<size_t>(999 - i));
+	}
+	assert(t.height() == 0);
+
+	try {
+		t.pop_min();
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: insert
+void test_bplus_tree_pop_max() {
+	tf::bplus_tree<int, std::string> t;
+	for (int i = 0; i < 1000; ++i) {
+		t.insert(i, std::to_string(i));
+	}
+
+	// -- //
+
+	for (int i = 999; i >= 0; --i) {
+		assert(t.pop_max() == std::to_string(i));
+		assert(t.size() == static_cast<size_t>(i));
+	}
+	assert(t.height() == 0);
+
+	try {
+		t.pop_max();
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: insert
+void test_bplus_tree_contains() {
+	tf::bplus_tree<int, std::string> t;
+
+	// -- //
+
+	assert(t.contains(1) == false);
+
+	for (int i = 0; i < 1000; i += 2) {
+		t.insert(i, std::to_string(i));
+	}
+
+	for (int i = 0; i < 1000; ++i) {
+		assert(t.contains(i) == (i % 2 == 0));
+	}
+}
+
+// prec: contains
+void test_bplus_tree_remove() {
+	tf::bplus_tree<int, std::string> t;
+
+	// -- //
+
+	try {
+		t.remove(1);
+		assert(false);
+	} catch (tf::exception &) {}
+
+	for (int i = 0; i < 3000; ++i) {
+		t.insert(i, std::to_string(i));
+	}
+
+	// removes from the middle first, so that leaves borrow from and merge with both siblings
+	for (int i = 1000; i < 2000; ++i) {
+		assert(t.remove(i) == std::to_string(i));
+	}
+	assert(t.size() == 2000);
+
+	for (int i = 0; i < 3000; ++i) {
+		assert(t.contains(i) == (i < 1000 || i >= 2000));
+	}
+
+	for (int i = 0; i < 1000; i += 2) {
+		assert(t.remove(i) == std::to_string(i));
+		assert(t.remove(2999 - i) == std::to_string(2999 - i));
+	}
+	assert(t.size() == 1000);
+
+	try {
+		t.remove(0);
+		assert(false);
+	} catch (tf::exception &) {}
+
+	for (int i = 1; i < 1000; i += 2) {
+		t.remove(i);
+		t.remove(2999 - i);
+	}
+	assert(t.size() == 0);
+	assert(t.height() == 0);
+
+	t.insert(1, "One");
+	assert(t.get(1) == "One");
+}
+
+// prec: insert, remove
+void test_bplus_tree_iteration() {
+	tf::bplus_tree<int, std::string> t;
+	t.insert(1, "One");
+	t.insert(-1, "nOne");
+	t.insert(10, "Ten");
+	t.insert(60, "Sixty");
+	t.insert(-100, "nHundred");
+	t.insert(7, "Seven");
+
+	const tf::bplus_tree<int, std::string> t2(t);
+
+	// -- //
+
+	int i = 0;
+	for (auto it = t.begin(); it.has_value(); ++it) {
+		switch (i) {
+		case 0: assert(*it == "nHundred"); break;
+		case 1: assert(*it == "nOne"); break;
+		case 2: assert(*it == "One"); break;
+		case 3: assert(*it == "Seven"); break;
+		case 4: assert(*it == "Ten"); break;
+		case 5: assert(*it == "Sixty"); break;
+		}
+		++i;
+	}
+	assert(i == 6);
+
+	for (auto it = t.end(); it.has_value(); --it) {
+		--i;
+		switch (i) {
+		case 5: assert(*it == "Sixty"); break;
+		case 4: assert(*it == "Ten"); break;
+		case 3: assert(*it == "Seven"); break;
+		case 2: assert(*it == "One"); break;
+		case 1: assert(*it == "nOne"); break;
+		case 0:
+			assert(it.key() == -100);
+			assert(it.value() == "nHundred");
+			it.value() = "New nHundred";
+			break;
+		}
+	}
+	assert(i == 0);
+	assert(t.get(-100) == "New nHundred");
+
+	for (auto it = t2.begin(); it.has_value(); ++it) {
+		++i;
+	}
+	assert(i == 6);
+	assert(t2.get(-100) == "nHundred");
+
+	// across leaves
+	tf::bplus_tree<int, int> t3;
+	for (int j = 0; j < 10000; ++j) {
+		t3.insert((j * 7919) % 10000, j);
+	}
+
+	int expected = 0;
+	for (auto it = t3.begin(); it.has_value(); ++it) {
+		assert(it.key() == expected);
+		++expected;
+	}
+	assert(expected == 10000);
+
+	for (auto it = t3.end(); it.has_value(); --it) {
+		--expected;
+		assert(it.key() == expected);
+	}
+	assert(expected == 0);
+
+	tf::bplus_tree<int, int> empty;
+	assert(empty.begin().has_value() == false);
+	assert(empty.end().has_value() == false);
+}
+
+// prec: remove
+void test_bplus_tree_empty() {
+	tf::bplus_tree<int, std::string> t;
+
+	// -- //
+
+	assert(t.empty() == true);
+
+	t.insert(1, "One");
+	assert(t.empty() == false);
+	t.insert(2, "Two");
+	assert(t.empty() == false);
+
+	t.remove(1);
+	assert(t.empty() == false);
+	t.remove(2);
+	assert(t.empty() == true);
+}
+
+// prec: empty
+void test_bplus_tree_clear() {
+	tf::bplus_tree<int, std::string> t;
+	for (int i = 0; i < 1000; ++i) {
+		t.insert(i, std::to_string(i));
+	}
+
+	// -- //
+
+	t.clear();
+	assert(t.size() == 0);
+	assert(t.height() == 0);
+	assert(t.begin().has_value() == false);
+
+	try {
+		t.min();
+		assert(false);
+	} catch (tf::exception &) {}
+
+	t.insert(1, "One");
+	assert(t.get(1) == "One");
+}
+
+// prec: remove, brackets_operator
+void test_bplus_tree_lookup_key() {
+	tf::bplus_tree<std::string, int> t;
+	t.insert("b", 2);
+	t.insert("a", 1);
+	t.insert("c", 3);
+	t.insert("ab", 12);
+
+	// -- //
+
+	std::string buffer = "abc";
+	std::string_view a(buffer.data(), 1);
+	std::string_view ab(buffer.data(), 2);
+	const char *c = "c";
+
+	assert(t.get(a) == 1);
+	assert(t.get(ab) == 12);
+	assert(t.get("b") == 2);
+	assert(t.contains(c) == true);
+	assert(t.contains(std::string_view(buffer.data() + 1, 2)) == false);
+
+	t[ab] = 120;
+	assert(t.get("ab") == 120);
+	const tf::bplus_tree<std::string, int> &const_t = t;
+	assert(const_t[a] == 1);
+
+	assert(t.remove(c) == 3);
+	assert(t.contains(c) == false);
+	assert(t.size() == 3);
+
+	try {
+		t.get(std::string_view("d"));
+		assert(false);
+	} catch (tf::exception &) {}
+
+	try {
+		t.remove(c);
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: insert, iteration
+void test_bplus_tree_find() {
+	tf::bplus_tree<int, std::string> t;
+	t.insert(1, "One");
+	t.insert(5, "Five");
+	t.insert(9, "Nine");
+
+	const tf::bplus_tree<int, std::string> &const_t = t;
+
+	// -- //
+
+	auto it = t.find(5);
+	assert(it.has_value() == true);
+	assert(it.key() == 5);
+	assert(*it == "Five");
+	++it;
+	assert(it.key() == 9);
+	++it;
+	assert(it.has_value() == false);
+
+	it = t.find(5);
+	--it;
+	assert(it.key() == 1);
+
+	it = t.find(9);
+	it.value() = "New Nine";
+	assert(t.get(9) == "New Nine");
+
+	assert(t.find(4).has_value() == false);
+	assert(t.find(10).has_value() == false);
+	assert(const_t.find(1).value() == "One");
+	assert(const_t.find(0).has_value() == false);
+
+	tf::bplus_tree<std::string, int> t2;
+	t2.insert("a", 1);
+	t2.insert("b", 2);
+	assert(*t2.find(std::string_view("b")) == 2);
+	assert(t2.find("c").has_value() == false);
+
+	tf::bplus_tree<int, int> empty;
+	assert(empty.find(1).has_value() == false);
+}
+
+// prec: insert, iteration
+void test_bplus_tree_bounds() {
+	tf::bplus_tree<int, int> t;
+	for (int i = 0; i < 100; i += 10) {
+		t.insert(i, i);
+	}
+
+	const tf::bplus_tree<int, int> &const_t = t;
+
+	// -- //
+
+	assert(t.lower_bound(-5).key() == 0);
+	assert(t.lower_bound(0).key() == 0);
+	assert(t.lower_bound(1).key() == 10);
+	assert(t.lower_bound(90).key() == 90);
+	assert(t.lower_bound(91).has_value() == false);
+
+	assert(t.upper_bound(-5).key() == 0);
+	assert(t.upper_bound(0).key() == 10);
+	assert(t.upper_bound(15).key() == 20);
+	assert(t.upper_bound(90).has_value() == false);
+
+	assert(const_t.lower_bound(35).key() == 40);
+	assert(const_t.upper_bound(40).key() == 50);
+
+	// the iterators are not limited
+	int count = 0;
+	for (auto it = t.lower_bound(45); it.has_value(); ++it) {
+		++count;
+	}
+	assert(count == 5);
+
+	for (auto it = t.upper_bound(45); it.has_value(); --it) {
+		++count;
+	}
+	assert(count == 11);
+
+	tf::bplus_tree<int, int> empty;
+	assert(empty.lower_bound(1).has_value() == false);
+	assert(empty.upper_bound(1).has_value() == false);
+
+	// -- //
+
+	// the bound can be the first entry of the next leaf
+	tf::bplus_tree<int, int> t2;
+	for (int i = 0; i < 100000; ++i) {
+		t2.insert(i * 2, i);
+	}
+
+	for (int i = -1; i < 200000; ++i) {
+		auto lower = t2.lower_bound(i);
+		auto upper = t2.upper_bound(i);
+		if (i >= 199998) {
+			assert(lower.has_value() == (i == 199998));
+			assert(upper.has_value() == false);
+			continue;
+		}
+
+		assert(lower.key() == ((i < 0) ? 0 : (i + 1) / 2 * 2));
+		assert(upper.key() == ((i < 0) ? 0 : i / 2 * 2 + 2));
+	}
+}
+
+// prec: insert, iteration, remove
+void test_bplus_tree_range() {
+	tf::bplus_tree<int, int> t;
+	for (int i = 0; i < 1000; ++i) {
+		t.insert(i, i);
+	}
+
+	const tf::bplus_tree<int, int> &const_t = t;
+
+	// -- //
+
+	int expected = 100;
+	for (auto it = t.range(100, 200); it.has_value(); ++it) {
+		assert(it.key() == expected);
+		++expected;
+	}
+	assert(expected == 200);
+
+	for (auto it = t.range(100, 200); it.has_value(); --it) {
+		--expected;
+	}
+	assert(expected == 199);
+
+	int count = 0;
+	for (auto it = t.range(499, 502); it.has_value(); ++it) {
+		++count;
+	}
+	assert(count == 3);
+
+	count = 0;
+	for (auto it = const_t.range(-10, 3); it.has_value(); ++it) {
+		++count;
+	}
+	assert(count == 3);
+
+	count = 0;
+	for (auto it = t.range(995, 2000); it.has_value(); ++it) {
+		it.value() = 0;
+		++count;
+	}
+	assert(count == 5);
+	assert(t.get(999) == 0);
+
+	assert(t.range(5, 5).has_value() == false);
+	assert(t.range(6, 5).has_value() == false);
+	assert(t.range(1000, 2000).has_value() == false);
+	assert(t.range(-2000, 0).has_value() == false);
+
+	for (int i = 0; i < 1000; i += 2) {
+		t.remove(i);
+	}
+
+	count = 0;
+	for (auto it = t.range(10, 20); it.has_value(); ++it) {
+		assert(it.key() % 2 == 1);
+		++count;
+	}
+	assert(count == 5);
+
+	// -- //
+
+	// ranges over many leaves end at the right entry in both directions
+	tf::bplus_tree<int, int> t2;
+	for (int i = 0; i < 100000; ++i) {
+		t2.insert((i * 7919) % 100000, i);
+	}
+
+	for (int first = 0; first < 100000; first += 9973) {
+		int last = first + 20000;
+		expected = first;
+		for (auto it = t2.range(first, last); it.has_value(); ++it) {
+			assert(it.key() == expected);
+			++expected;
+		}
+		assert(expected == ((last < 100000) ? last : 100000));
+
+		for (auto it = t2.range(first, last); it.has_value(); --it) {
+			assert(it.key() == first);
+			--expected;
+		}
+		assert(expected == ((last < 100000) ? last : 100000) - 1);
+	}
+
+	tf::bplus_tree<std::string, int> t3;
+	t3.insert("a", 1);
+	t3.insert("ab", 2);
+	t3.insert("b", 3);
+	t3.insert("c", 4);
+
+	count = 0;
+	for (auto it = t3.range(std::string_view("a"), std::string_view("b")); it.has_value(); ++it) {
+		++count;
+	}
+	assert(count == 2);
+}
+
+// prec: insert, remove, iteration
+void test_bplus_tree_random_operations() {
+	tf::bplus_tree<int, int> t;
+	std::map<int, int> expected;
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<int> keys(0, 4000);
+
+	// -- //
+
+	for (int i = 0; i < 100000; ++i) {
+		int key = keys(generator);
+		if (generator() % 3 == 0) {
+			if (expected.count(key)) {
+				assert(t.remove(key) == expected[key]);
+				expected.erase(key);
+			}
+			else {
+				assert(t.contains(key) == false);
+			}
+		}
+		else if (!expected.count(key)) {
+			t.insert(key, i);
+			expected[key] = i;
+		}
+	}
+	assert(t.size() == expected.size());
+
+	auto expected_it = expected.begin();
+	for (auto it = t.begin(); it.has_value(); ++it, ++expected_it) {
+		assert(it.key() == expected_it->first);
+		assert(*it == expected_it->second);
+	}
+	assert(expected_it == expected.end());
+
+	// bounds after leaves have been merged and refilled
+	for (int key = -1; key <= 4001; ++key) {
+		auto lower = t.lower_bound(key);
+		auto expected_lower = expected.lower_bound(key);
+		assert(lower.has_value() == (expected_lower != expected.end()));
+		if (lower.has_value())
+			assert(lower.key() == expected_lower->first);
+
+		auto upper = t.upper_bound(key);
+		auto expected_upper = expected.upper_bound(key);
+		assert(upper.has_value() == (expected_upper != expected.end()));
+		if (upper.has_value())
+			assert(upper.key() == expected_upper->first);
+	}
+
+	while (!expected.empty()) {
+		assert(t.pop_min() == expected.begin()->second);
+		expected.erase(expected.begin());
+	}
+	assert(t.empty() == true);
+}
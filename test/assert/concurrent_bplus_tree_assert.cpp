@@ -0,0 +1,381 @@
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include "../../tfds/tf_concurrent_bplus_tree.hpp"
+
+void test_concurrent_bplus_tree();
+void test_concurrent_bplus_tree_default_constructor();
+void test_concurrent_bplus_tree_insert();
+void test_concurrent_bplus_tree_get();
+void test_concurrent_bplus_tree_assign();
+void test_concurrent_bplus_tree_contains();
+void test_concurrent_bplus_tree_remove();
+void test_concurrent_bplus_tree_min_max();
+void test_concurrent_bplus_tree_pop();
+void test_concurrent_bplus_tree_clear();
+void test_concurrent_bplus_tree_splits();
+void test_concurrent_bplus_tree_threads();
+void test_concurrent_bplus_tree_pop_threads();
+
+
+/* int main(int argc, char *argv[]) {
+	test_concurrent_bplus_tree();
+
+	return 0;
+} */
+
+void test_concurrent_bplus_tree() {
+	test_concurrent_bplus_tree_default_constructor();
+	test_concurrent_bplus_tree_insert();
+	test_concurrent_bplus_tree_get();
+	test_concurrent_bplus_tree_assign();
+	test_concurrent_bplus_tree_contains();
+	test_concurrent_bplus_tree_remove();
+	test_concurrent_bplus_tree_min_max();
+	test_concurrent_bplus_tree_pop();
+	test_concurrent_bplus_tree_clear();
+	test_concurrent_bplus_tree_splits();
+	test_concurrent_bplus_tree_threads();
+	test_concurrent_bplus_tree_pop_threads();
+
+	std::cout << "CONCURRENT B+ TREE tests successful." << std::endl;
+}
+
+// prec: -
+void test_concurrent_bplus_tree_default_constructor() {
+	tf::concurrent_bplus_tree<int, int> t;
+	assert(t.size() == 0);
+	assert(t.height() == 1);
+	assert(t.empty() == true);
+}
+
+// prec: default_constructor
+void test_concurrent_bplus_tree_insert() {
+	tf::concurrent_bplus_tree<int, int> t;
+
+	// -- //
+
+	t.insert(5, 50);
+	assert(t.size() == 1);
+	assert(t.empty() == false);
+
+	t.insert(3, 30);
+	t.insert(8, 80);
+	assert(t.size() == 3);
+
+	// -- //
+
+	bool thrown = false;
+	try {
+		t.insert(3, 31);
+	}
+	catch (tf::exception &e) {
+		thrown = true;
+	}
+	assert(thrown);
+	assert(t.size() == 3);
+	assert(t.get(3) == 30);
+}
+
+// prec: insert
+void test_concurrent_bplus_tree_get() {
+	tf::concurrent_bplus_tree<int, double> t;
+	t.insert(1, 1.5);
+	t.insert(-2, 2.5);
+
+	// -- //
+
+	assert(t.get(1) == 1.5);
+	assert(t.get(-2) == 2.5);
+
+	bool thrown = false;
+	try {
+		t.get(2);
+	}
+	catch (tf::exception &e) {
+		thrown = true;
+	}
+	assert(thrown);
+}
+
+// prec: get
+void test_concurrent_bplus_tree_assign() {
+	tf::concurrent_bplus_tree<int, int> t;
+	t.insert(1, 10);
+
+	// -- //
+
+	t.assign(1, 11);
+	assert(t.get(1) == 11);
+	assert(t.size() == 1);
+
+	bool thrown = false;
+	try {
+		t.assign(2, 20);
+	}
+	catch (tf::exception &e) {
+		thrown = true;
+	}
+	assert(thrown);
+	assert(t.size() == 1);
+}
+
+// prec: insert
+void test_concurrent_bplus_tree_contains() {
+	tf::concurrent_bplus_tree<int, int> t;
+	assert(t.contains(1) == false);
+
+	// -- //
+
+	t.insert(1, 10);
+	assert(t.contains(1) == true);
+	assert(t.contains(0) == false);
+	assert(t.contains(2) == false);
+}
+
+// prec: contains
+void test_concurrent_bplus_tree_remove() {
+	tf::concurrent_bplus_tree<int, int> t;
+	t.insert(1, 10);
+	t.insert(2, 20);
+
+	// -- //
+
+	assert(t.remove(1) == 10);
+	assert(t.size() == 1);
+	assert(t.contains(1) == false);
+	assert(t.contains(2) == true);
+
+	bool thrown = false;
+	try {
+		t.remove(1);
+	}
+	catch (tf::exception &e) {
+		thrown = true;
+	}
+	assert(thrown);
+
+	// -- //
+
+	assert(t.remove(2) == 20);
+	assert(t.empty() == true);
+
+	t.insert(1, 11);
+	assert(t.get(1) == 11);
+}
+
+// prec: remove
+void test_concurrent_bplus_tree_min_max() {
+	tf::concurrent_bplus_tree<int, int> t;
+
+	bool thrown = false;
+	try {
+		t.min();
+	}
+	catch (tf::exception &e) {
+		thrown = true;
+	}
+	assert(thrown);
+
+	thrown = false;
+	try {
+		t.max();
+	}
+	catch (tf::exception &e) {
+		thrown = true;
+	}
+	assert(thrown);
+
+	// -- //
+
+	for (int i = 0; i < 10000; ++i) {
+		t.insert((i * 7919) % 10000, i);
+	}
+	assert(t.min() == 0);
+	assert(t.max() == t.get(9999));
+
+	// -- //
+
+	// the leaves at both ends become empty, but are not removed
+	for (int i = 0; i < 2000; ++i) {
+		t.remove(i);
+		t.remove(9999 - i);
+	}
+	assert(t.min() == t.get(2000));
+	assert(t.max() == t.get(7999));
+}
+
+// prec: min_max
+void test_concurrent_bplus_tree_pop() {
+	tf::concurrent_bplus_tree<int, int> t;
+	for (int i = 0; i < 5000; ++i) {
+		t.insert(i, i * 2);
+	}
+
+	// -- //
+
+	for (int i = 0; i < 2500; ++i) {
+		assert(t.pop_min() == i * 2);
+		assert(t.pop_max() == (4999 - i) * 2);
+	}
+	assert(t.empty() == true);
+
+	bool thrown = false;
+	try {
+		t.pop_min();
+	}
+	catch (tf::exception &e) {
+		thrown = true;
+	}
+	assert(thrown);
+
+	thrown = false;
+	try {
+		t.pop_max();
+	}
+	catch (tf::exception &e) {
+		thrown = true;
+	}
+	assert(thrown);
+}
+
+// prec: insert
+void test_concurrent_bplus_tree_clear() {
+	tf::concurrent_bplus_tree<int, int> t;
+	for (int i = 0; i < 10000; ++i) {
+		t.insert(i, i);
+	}
+	assert(t.height() > 1);
+
+	// -- //
+
+	t.clear();
+	assert(t.size() == 0);
+	assert(t.height() == 1);
+	assert(t.contains(0) == false);
+
+	t.insert(1, 1);
+	assert(t.get(1) == 1);
+}
+
+// prec: remove
+void test_concurrent_bplus_tree_splits() {
+	tf::concurrent_bplus_tree<long long, long long> t;
+	const long long num_keys = 100000;
+
+	// -- //
+
+	// ascending, descending and scattered inserts split leaves and inner nodes at every position
+	for (long long i = 0; i < num_keys; ++i) {
+		t.insert(i * 3, i);
+		t.insert(-i * 3 - 1, i);
+		t.insert((i * 7919) % num_keys * 3 + 1, i);
+	}
+	assert(t.size() == 3 * num_keys);
+	assert(t.height() > 2);
+
+	for (long long i = 0; i < num_keys; ++i) {
+		assert(t.get(i * 3) == i);
+		assert(t.get(-i * 3 - 1) == i);
+		assert(t.contains(i * 3 + 2) == false);
+	}
+	assert(t.min() == num_keys - 1);
+
+	// -- //
+
+	for (long long i = 0; i < num_keys; i += 2) {
+		t.remove(i * 3);
+	}
+	for (long long i = 0; i < num_keys; ++i) {
+		assert(t.contains(i * 3) == (i % 2 == 1));
+	}
+	assert(t.size() == 3 * num_keys - num_keys / 2);
+}
+
+// prec: splits
+void test_concurrent_bplus_tree_threads() {
+	const int num_threads = 4;
+	const int num_keys = 20000;
+	tf::concurrent_bplus_tree<int, int> t;
+
+	// -- //
+
+	// writers insert, update and remove interleaved key ranges, which splits the nodes the readers
+	// pass, while readers check the keys that never change
+	for (int i = 0; i < num_keys; ++i) {
+		t.insert(-i - 1, i);
+	}
+
+	std::vector<std::thread> threads;
+	for (int w = 0; w < num_threads; ++w) {
+		threads.emplace_back([&t, w, num_keys]() {
+			for (int i = w; i < num_keys; i += num_threads) {
+				t.insert(i, i);
+				t.assign(i, i * 2);
+			}
+
+			for (int i = w; i < num_keys; i += 2 * num_threads) {
+				assert(t.remove(i) == i * 2);
+			}
+		});
+
+		threads.emplace_back([&t, num_keys]() {
+			for (int i = 0; i < num_keys; ++i) {
+				assert(t.get(-i - 1) == i);
+				assert(t.min() == num_keys - 1);
+			}
+		});
+	}
+
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+
+	assert(t.size() == num_keys + num_keys / 2);
+	for (int i = 0; i < num_keys; ++i) {
+		assert(t.get(-i - 1) == i);
+
+		bool removed = (i % (2 * num_threads)) < num_threads;
+		assert(t.contains(i) == !removed);
+		if (!removed)
+			assert(t.get(i) == i * 2);
+	}
+}
+
+// prec: threads
+void test_concurrent_bplus_tree_pop_threads() {
+	const int num_threads = 4;
+	const int num_keys = 20000;
+	tf::concurrent_bplus_tree<int, int> t;
+	for (int i = 0; i < num_keys; ++i) {
+		t.insert(i, i);
+	}
+
+	// -- //
+
+	// every entry is popped by exactly one thread
+	std::vector<std::atomic<int>> popped(num_keys);
+	for (std::atomic<int> &count : popped) {
+		count.store(0);
+	}
+
+	std::vector<std::thread> threads;
+	for (int p = 0; p < num_threads; ++p) {
+		threads.emplace_back([&t, &popped, p, num_keys]() {
+			for (int i = 0; i < num_keys / num_threads; ++i) {
+				popped[(p % 2 == 0) ? t.pop_min() : t.pop_max()].fetch_add(1);
+			}
+		});
+	}
+
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+
+	assert(t.empty() == true);
+	for (std::atomic<int> &count : popped) {
+		assert(count.load() == 1);
+	}
+}
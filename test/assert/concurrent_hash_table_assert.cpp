@@ -0,0 +1,211 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../tfds/tf_concurrent_hash_table.hpp"
+
+void test_concurrent_table();
+void test_concurrent_table_default_constructor();
+void test_concurrent_table_insert();
+void test_concurrent_table_get();
+void test_concurrent_table_assign();
+void test_concurrent_table_contains();
+void test_concurrent_table_remove();
+void test_concurrent_table_growth();
+void test_concurrent_table_threads();
+
+
+/* int main(int argc, char *argv[]) {
+	test_concurrent_table();
+
+	return 0;
+} */
+
+void test_concurrent_table() {
+	test_concurrent_table_default_constructor();
+	test_concurrent_table_insert();
+	test_concurrent_table_get();
+	test_concurrent_table_assign();
+	test_concurrent_table_contains();
+	test_concurrent_table_remove();
+	test_concurrent_table_growth();
+	test_concurrent_table_threads();
+
+	std::cout << "CONCURRENT HASH TABLE tests successful." << std::endl;
+}
+
+// prec: -
+void test_concurrent_table_default_constructor() {
+	tf::concurrent_hash_table<std::string, int> h;
+	assert(h.size() == 0);
+	assert(h.table_size() == 100);
+	assert(h.empty() == true);
+
+	tf::concurrent_hash_table<std::string, int> h2(0);
+	assert(h2.table_size() == 1);
+}
+
+// prec: default_constructor
+void test_concurrent_table_insert() {
+	tf::concurrent_hash_table<std::string, int> h;
+
+	// -- //
+
+	h.insert("One", 1);
+	assert(h.size() == 1);
+
+	h.insert("Two", 2);
+	assert(h.size() == 2);
+
+	try {
+		h.insert("Two", 22);
+		assert(false);
+	} catch (tf::exception &) {}
+	assert(h.size() == 2);
+}
+
+// prec: insert
+void test_concurrent_table_get() {
+	tf::concurrent_hash_table<std::string, int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+	h.insert("Three", 3);
+
+	// -- //
+
+	assert(h.get("One") == 1);
+	assert(h.get("Two") == 2);
+	assert(h.get("Three") == 3);
+
+	try {
+		h.get("Four");
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: get
+void test_concurrent_table_assign() {
+	tf::concurrent_hash_table<std::string, int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+
+	// -- //
+
+	h.assign("One", 11);
+	assert(h.get("One") == 11);
+	assert(h.get("Two") == 2);
+	assert(h.size() == 2);
+
+	try {
+		h.assign("Three", 3);
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: insert
+void test_concurrent_table_contains() {
+	tf::concurrent_hash_table<std::string, int> h;
+
+	// -- //
+
+	assert(h.contains("One") == false);
+	h.insert("One", 1);
+	assert(h.contains("One") == true);
+	assert(h.contains("Two") == false);
+}
+
+// prec: contains
+void test_concurrent_table_remove() {
+	tf::concurrent_hash_table<std::string, int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+
+	// -- //
+
+	assert(h.remove("One") == 1);
+	assert(h.size() == 1);
+	assert(h.contains("One") == false);
+
+	assert(h.remove("Two") == 2);
+	assert(h.empty() == true);
+
+	try {
+		h.remove("Two");
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: remove
+void test_concurrent_table_growth() {
+	tf::concurrent_hash_table<int, int> h(1);
+
+	// -- //
+
+	for (int i = 0; i < 10000; ++i) {
+		h.insert(i, i * 2);
+	}
+	assert(h.size() == 10000);
+	assert(h.table_size() > 1);
+
+	for (int i = 0; i < 10000; ++i) {
+		assert(h.get(i) == i * 2);
+	}
+
+	for (int i = 0; i < 10000; i += 2) {
+		assert(h.remove(i) == i * 2);
+	}
+	assert(h.size() == 5000);
+
+	for (int i = 0; i < 10000; ++i) {
+		assert(h.contains(i) == (i % 2 == 1));
+	}
+}
+
+// prec: growth
+void test_concurrent_table_threads() {
+	const int num_threads = 4;
+	const int num_keys = 20000;
+	tf::concurrent_hash_table<int, int> h(16);
+
+	// -- //
+
+	// writers insert, update and remove disjoint key ranges while readers check the keys that never change
+	for (int i = 0; i < num_keys; ++i) {
+		h.insert(-i - 1, i);
+	}
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < num_threads; ++t) {
+		threads.emplace_back([&h, t, num_keys]() {
+			for (int i = t; i < num_keys; i += num_threads) {
+				h.insert(i, i);
+				h.assign(i, i * 2);
+			}
+
+			for (int i = t; i < num_keys; i += 2 * num_threads) {
+				assert(h.remove(i) == i * 2);
+			}
+		});
+
+		threads.emplace_back([&h, num_keys]() {
+			for (int i = 0; i < num_keys; ++i) {
+				assert(h.get(-i - 1) == i);
+			}
+		});
+	}
+
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+
+	assert(h.size() == num_keys + num_keys / 2);
+	for (int i = 0; i < num_keys; ++i) {
+		assert(h.get(-i - 1) == i);
+
+		bool removed = (i % (2 * num_threads)) < num_threads;
+		assert(h.contains(i) == !removed);
+		if (!removed)
+			assert(h.get(i) == i * 2);
+	}
+}
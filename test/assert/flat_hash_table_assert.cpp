@@ -0,0 +1,379 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+#include "../../tfds/tf_flat_hash_table.hpp"
+
+void test_flat_table();
+void test_flat_table_default_constructor();
+void test_flat_table_insert();
+void test_flat_table_get();
+void test_flat_table_copy_constructor();
+void test_flat_table_swap();
+void test_flat_table_move_constructor();
+void test_flat_table_copy_assignment();
+void test_flat_table_contains();
+void test_flat_table_remove();
+void test_flat_table_brackets_operator();
+void test_flat_table_iteration();
+void test_flat_table_empty();
+void test_flat_table_clear();
+void test_flat_table_growth();
+
+
+/* int main(int argc, char *argv[]) {
+	test_flat_table();
+
+	return 0;
+} */
+
+void test_flat_table() {
+	test_flat_table_default_constructor();
+	test_flat_table_insert();
+	test_flat_table_get();
+	test_flat_table_copy_constructor();
+	test_flat_table_swap();
+	test_flat_table_move_constructor();
+	test_flat_table_copy_assignment();
+	test_flat_table_contains();
+	test_flat_table_remove();
+	test_flat_table_brackets_operator();
+	test_flat_table_iteration();
+	test_flat_table_empty();
+	test_flat_table_clear();
+	test_flat_table_growth();
+
+	std::cout << "FLAT HASH TABLE tests successful." << std::endl;
+}
+
+// prec: -
+void test_flat_table_default_constructor() {
+	tf::flat_hash_table<std::string, int> h;
+	assert(h.size() == 0);
+	assert(h.capacity() > 0);
+
+	tf::flat_hash_table<std::string, int> h2(1000);
+	assert(h2.size() == 0);
+	assert(h2.capacity() >= 1000);
+}
+
+// prec: default_constructor
+void test_flat_table_insert() {
+	tf::flat_hash_table<std::string, int> h;
+
+	// -- //
+
+	h.insert("One", 1);
+	assert(h.size() == 1);
+
+	h.insert("Two", 2);
+	assert(h.size() == 2);
+
+	h.insert("Three", 3);
+	assert(h.size() == 3);
+
+	h.insert("Four", 4);
+	assert(h.size() == 4);
+
+	try {
+		h.insert("Two", 22);
+		assert(false);
+	} catch (tf::exception &) {}
+	assert(h.size() == 4);
+}
+
+// prec: insert
+void test_flat_table_get() {
+	tf::flat_hash_table<std::string, int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+	h.insert("Three", 3);
+	h.insert("Four", 4);
+
+	// -- //
+
+	assert(h.get("One") == 1);
+	assert(h.get("Two") == 2);
+	assert(h.get("Three") == 3);
+	assert(h.get("Four") == 4);
+
+	try {
+		h.get("Five");
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: get
+void test_flat_table_copy_constructor() {
+	tf::flat_hash_table<std::string, int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+	h.insert("Three", 3);
+	h.insert("Four", 4);
+
+	// -- //
+
+	tf::flat_hash_table<std::string, int> h2(h);
+	assert(h2.size() == 4);
+	assert(h2.capacity() == h.capacity());
+	assert(h2.get("One") == 1);
+	assert(h2.get("Two") == 2);
+	assert(h2.get("Three") == 3);
+	assert(h2.get("Four") == 4);
+
+	h2.insert("Five", 5);
+	assert(h.size() == 4);
+	assert(h.contains("Five") == false);
+}
+
+// prec: get
+void test_flat_table_swap() {
+	tf::flat_hash_table<std::string, int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+
+	tf::flat_hash_table<std::string, int> h2(1000);
+	h2.insert("One", 3);
+	h2.insert("Two", 3);
+	h2.insert("Three", 3);
+
+	size_t capacity = h.capacity();
+	size_t capacity2 = h2.capacity();
+
+	// -- //
+
+	swap(h, h2);
+
+	assert(h.size() == 3);
+	assert(h.capacity() == capacity2);
+	assert(h.get("One") == 3);
+	assert(h.get("Two") == 3);
+	assert(h.get("Three") == 3);
+
+	assert(h2.size() == 2);
+	assert(h2.capacity() == capacity);
+	assert(h2.get("One") == 1);
+	assert(h2.get("Two") == 2);
+}
+
+// prec: get
+void test_flat_table_move_constructor() {
+	tf::flat_hash_table<std::string, int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+	h.insert("Three", 3);
+	h.insert("Four", 4);
+
+	// -- //
+
+	tf::flat_hash_table<std::string, int> h2(std::move(h));
+	assert(h2.size() == 4);
+	assert(h2.get("One") == 1);
+	assert(h2.get("Two") == 2);
+	assert(h2.get("Three") == 3);
+	assert(h2.get("Four") == 4);
+}
+
+// prec: get
+void test_flat_table_copy_assignment() {
+	tf::flat_hash_table<std::string, int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+	h.insert("Three", 3);
+	h.insert("Four", 4);
+
+	// -- //
+
+	tf::flat_hash_table<std::string, int> h2;
+	h2 = h;
+
+	assert(h2.size() == 4);
+	assert(h2.get("One") == 1);
+	assert(h2.get("Two") == 2);
+	assert(h2.get("Three") == 3);
+	assert(h2.get("Four") == 4);
+}
+
+// prec: insert
+void test_flat_table_contains() {
+	tf::flat_hash_table<std::string, int> h;
+
+	// -- //
+
+	assert(h.contains("One") == false);
+	h.insert("One", 1);
+	assert(h.contains("One") == true);
+
+	assert(h.contains("Two") == false);
+	h.insert("Two", 2);
+	assert(h.contains("One") == true);
+	assert(h.contains("Two") == true);
+
+	assert(h.contains("Three") == false);
+	h.insert("Three", 3);
+	assert(h.contains("One") == true);
+	assert(h.contains("Two") == true);
+	assert(h.contains("Three") == true);
+}
+
+// prec: contains
+void test_flat_table_remove() {
+	tf::flat_hash_table<std::string, int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+	h.insert("Three", 3);
+	h.insert("Four", 4);
+
+	// -- //
+
+	try {
+		h.remove("Five");
+		assert(false);
+	} catch (tf::exception &) {}
+
+	assert(h.remove("One") == 1);
+	assert(h.size() == 3);
+	assert(h.contains("One") == false);
+
+	assert(h.remove("Three") == 3);
+	assert(h.size() == 2);
+	assert(h.contains("Three") == false);
+
+	assert(h.remove("Four") == 4);
+	assert(h.size() == 1);
+	assert(h.contains("Four") == false);
+
+	assert(h.remove("Two") == 2);
+	assert(h.size() == 0);
+	assert(h.contains("Two") == false);
+
+	try {
+		h.remove("One");
+		assert(false);
+	} catch (tf::exception &) {}
+
+	h.insert("One", 11);
+	assert(h.get("One") == 11);
+}
+
+// prec: insert
+void test_flat_table_brackets_operator() {
+	tf::flat_hash_table<std::string, int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+	h.insert("Three", 3);
+	h.insert("Four", 4);
+
+	// -- //
+
+	assert(h["One"] == 1);
+	assert(h["Two"] == 2);
+	assert(h["Three"] == 3);
+	assert(h["Four"] == 4);
+
+	h["One"] = 11;
+	assert(h.get("One") == 11);
+
+	try {
+		h["Five"];
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: insert
+void test_flat_table_iteration() {
+	tf::flat_hash_table<std::string, int> h;
+
+	// -- //
+
+	assert(h.begin().has_value() == false);
+
+	h.insert("One", 1);
+	h.insert("Two", 2);
+	h.insert("Three", 3);
+	h.insert("Four", 4);
+
+	int i = 0;
+	for (auto it = h.begin(); it.has_value(); ++it) {
+		assert(*it == 1 || *it == 2 || *it == 3 || *it == 4);
+		assert(h.get(it.key()) == it.value());
+		++i;
+	}
+	assert(i == 4);
+}
+
+// prec: remove
+void test_flat_table_empty() {
+	tf::flat_hash_table<std::string, int> h;
+
+	// -- //
+
+	assert(h.empty() == true);
+
+	h.insert("One", 1);
+	assert(h.empty() == false);
+	h.insert("Two", 2);
+	assert(h.empty() == false);
+
+	h.remove("One");
+	assert(h.empty() == false);
+	h.remove("Two");
+	assert(h.empty() == true);
+}
+
+// prec: empty
+void test_flat_table_clear() {
+	tf::flat_hash_table<std::string, int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+	h.insert("Three", 3);
+
+	// -- //
+
+	h.clear();
+	assert(h.size() == 0);
+	assert(h.empty() == true);
+
+	try {
+		h["One"];
+		assert(false);
+	} catch (tf::exception &) {}
+
+	h.insert("One", 1);
+	assert(h.get("One") == 1);
+}
+
+// prec: clear
+void test_flat_table_growth() {
+	tf::flat_hash_table<int, int> h;
+	size_t initial_capacity = h.capacity();
+
+	// -- //
+
+	for (int i = 0; i < 10000; ++i) {
+		h.insert(i, i * 2);
+	}
+	assert(h.size() == 10000);
+	assert(h.capacity() > initial_capacity);
+
+	for (int i = 0; i < 10000; ++i) {
+		assert(h.get(i) == i * 2);
+	}
+
+	// many removals and reinsertions leave deleted slots behind
+	for (int run = 0; run < 10; ++run) {
+		for (int i = 0; i < 10000; i += 2) {
+			assert(h.remove(i) == i * 2);
+		}
+		for (int i = 0; i < 10000; i += 2) {
+			h.insert(i, i * 2);
+		}
+	}
+	assert(h.size() == 10000);
+
+	size_t count = 0;
+	for (auto it = h.begin(); it.has_value(); ++it) {
+		assert(*it == it.key() * 2);
+		++count;
+	}
+	assert(count == 10000);
+}
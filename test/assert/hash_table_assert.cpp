@@ -1,7 +1,40 @@
 #include <cassert>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <cstring>
+#include <functional>
 #include "../../tfds/tf_hash_table.hpp"
 
+// key without padding bytes (hashed as a block of memory)
+struct table_assert_point {
+	int x;
+	int y;
+
+	bool operator==(const table_assert_point &other) const { return x == other.x && y == other.y; }
+};
+
+// key with padding bytes (needs a specialization of tf::hash)
+struct table_assert_record {
+	char type;
+	long long id;
+
+	bool operator==(const table_assert_record &other) const { return type == other.type && id == other.id; }
+};
+
+namespace tf {
+template <>
+inline uint64_t hash<table_assert_record>(const table_assert_record &key) {
+	return hash_combine(hash(key.type), hash(key.id));
+}
+}
+
+enum class table_assert_color { red, green };
+
 void test_table();
 void test_table_default_constructor();
 void test_table_insert();
@@ -16,6 +49,20 @@ void test_table_brackets_operator();
 void test_table_iteration();
 void test_table_empty();
 void test_table_clear();
+void test_table_growth();
+void test_table_rehash();
+void test_table_lookup_key();
+void test_table_get_many();
+void test_table_emplace();
+void test_table_try_emplace();
+void test_table_insert_or_assign();
+void test_table_insert_or_combine();
+void test_table_statistics();
+void test_table_key_types();
+void test_table_multimap();
+void test_table_insert_many();
+void test_table_insertion_order();
+void test_table_bloom_filter();
 
 
 /* int main(int argc, char *argv[]) {
@@ -38,6 +85,20 @@ void test_table() {
 	test_table_iteration();
 	test_table_empty();
 	test_table_clear();
+	test_table_growth();
+	test_table_rehash();
+	test_table_lookup_key();
+	test_table_get_many();
+	test_table_emplace();
+	test_table_try_emplace();
+	test_table_insert_or_assign();
+	test_table_insert_or_combine();
+	test_table_statistics();
+	test_table_key_types();
+	test_table_multimap();
+	test_table_insert_many();
+	test_table_insertion_order();
+	test_table_bloom_filter();
 
 	std::cout << "HASH TABLE tests successful." << std::endl;
 }
@@ -298,6 +359,7 @@ void test_table_iteration() {
 	int i = 0;
 	for (auto it = h.begin(); it.has_value(); ++it) {
 		assert(*it == 1 || *it == 2 || *it == 3 || *it == 4);
+		assert(it.hash_value() == tf::hasher<std::string>()(it.key()));
 		++i;
 	}
 	assert(i == 4);
@@ -341,4 +403,733 @@ void test_table_clear() {
 		h["One"];
 		assert(false);
 	} catch (tf::exception &) {}
-}
\ No newline at end of file
+}
+
+// prec: clear
+void test_table_growth() {
+	tf::hash_table<int, int> h(1);
+	assert(h.max_load_factor() == 1.0f);
+
+	// -- //
+
+	for (int i = 0; i < 10000; ++i) {
+		h.insert(i, i * 2);
+		assert(h.size() <= h.table_size() * h.max_load_factor());
+	}
+	assert(h.size() == 10000);
+
+	for (int i = 0; i < 10000; ++i) {
+		assert(h.get(i) == i * 2);
+	}
+
+	// entries are found while the old table is migrated
+	while (!h.rehashing()) {
+		h.insert(h.size(), h.size() * 2);
+	}
+
+	int n = h.size();
+	for (int i = 0; i < n; ++i) {
+		assert(h.contains(i) == true);
+	}
+
+	int count = 0;
+	for (auto it = h.begin(); it.has_value(); ++it) {
+		assert(*it == it.key() * 2);
+		++count;
+	}
+	assert(count == n);
+
+	tf::hash_table<int, int> h2(h);
+	assert(h2.size() == h.size());
+	assert(h2.rehashing() == false);
+	for (int i = 0; i < n; ++i) {
+		assert(h2.get(i) == i * 2);
+	}
+
+	for (int i = 0; i < n; ++i) {
+		assert(h.remove(i) == i * 2);
+	}
+	assert(h.empty() == true);
+	assert(h.rehashing() == false);
+
+	try {
+		h.insert(1, 1);
+		h.insert(1, 1);
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: growth
+void test_table_rehash() {
+	tf::hash_table<int, int> h(10);
+	for (int i = 0; i < 8; ++i) {
+		h.insert(i, i);
+	}
+
+	// -- //
+
+	h.rehash(1000);
+	assert(h.table_size() == 1000);
+	assert(h.rehashing() == false);
+	assert(h.size() == 8);
+
+	h.rehash(1);
+	assert(h.table_size() == 8);
+
+	h.reserve(500);
+	assert(h.table_size() == 500);
+	h.reserve(100);
+	assert(h.table_size() == 500);
+
+	h.shrink_to_fit();
+	assert(h.table_size() == 8);
+
+	h.set_max_load_factor(0.5f);
+	h.shrink_to_fit();
+	assert(h.table_size() == 16);
+	assert(h.load_factor() == 0.5f);
+
+	for (int i = 0; i < 8; ++i) {
+		assert(h.get(i) == i);
+	}
+
+	try {
+		h.set_max_load_factor(0.0f);
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: remove, brackets_operator
+void test_table_lookup_key() {
+	tf::hash_table<std::string, int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+	h.insert("Three", 3);
+
+	// -- //
+
+	std::string buffer = "OneTwoThree";
+	std::string_view one(buffer.data(), 3);
+	std::string_view two(buffer.data() + 3, 3);
+	const char *three = "Three";
+
+	assert(h.get(one) == 1);
+	assert(h.get(two) == 2);
+	assert(h.get(three) == 3);
+	assert(h.get("Three") == 3);
+	assert(h.contains(std::string_view(buffer.data(), 2)) == false);
+
+	h[two] = 22;
+	assert(h.get("Two") == 22);
+	const tf::hash_table<std::string, int> &c = h;
+	assert(c[three] == 3);
+
+	assert(h.remove(one) == 1);
+	assert(h.contains(one) == false);
+	assert(h.size() == 2);
+
+	try {
+		h.get(one);
+		assert(false);
+	} catch (tf::exception &) {}
+
+	try {
+		h.remove(std::string_view("Four"));
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: growth
+void test_table_get_many() {
+	tf::hash_table<int, int> h(1);
+	for (int i = 0; i < 530; ++i) {
+		h.insert(i, i * 2);
+	}
+
+	// -- //
+
+	// more keys than one batch, every third key does not exist, the table is still migrating
+	assert(h.rehashing() == true);
+	int keys[100];
+	for (int i = 0; i < 100; ++i) {
+		keys[i] = (i % 3 == 0) ? -i - 1 : i * 5;
+	}
+
+	const int *values[100];
+	bool results[100];
+	assert(h.get_many(keys, 100, values) == 66);
+	assert(h.contains_many(keys, 100, results) == 66);
+
+	for (int i = 0; i < 100; ++i) {
+		if (i % 3 == 0) {
+			assert(values[i] == nullptr);
+			assert(results[i] == false);
+		}
+		else {
+			assert(*values[i] == i * 10);
+			assert(values[i] == &h.get(i * 5));
+			assert(results[i] == true);
+		}
+	}
+
+	assert(h.get_many(keys, 0, values) == 0);
+
+	tf::hash_table<std::string, int> h2;
+	h2.insert("One", 1);
+	std::string string_keys[2] = { "Two", "One" };
+	const int *string_values[2];
+	assert(h2.get_many(string_keys, 2, string_values) == 1);
+	assert(string_values[0] == nullptr);
+	assert(*string_values[1] == 1);
+}
+
+// prec: remove
+void test_table_emplace() {
+	tf::hash_table<std::string, std::vector<int>> h;
+	std::vector<int> values(100, 1);
+	const int *data = values.data();
+
+	// -- //
+
+	// the vector is moved into the table and out of it again
+	h.insert("One", std::move(values));
+	assert(h.get("One").data() == data);
+
+	std::vector<int> &v = h.emplace("Two", 3, 2);
+	assert(v.size() == 3 && v[0] == 2);
+	assert(&h.get("Two") == &v);
+	assert(h.size() == 2);
+
+	try {
+		h.emplace("Two", 5, 5);
+		assert(false);
+	} catch (tf::exception &) {}
+	assert(h.get("Two").size() == 3);
+
+	std::vector<int> removed = h.remove("One");
+	assert(removed.data() == data);
+
+	// values that can only be moved
+	tf::hash_table<int, std::unique_ptr<int>> h2;
+	h2.insert(1, std::unique_ptr<int>(new int(1)));
+	h2.emplace(2, new int(2));
+	assert(*h2.get(1) == 1);
+	assert(*h2.get(2) == 2);
+
+	std::unique_ptr<int> p = h2.remove(1);
+	assert(*p == 1);
+	assert(h2.size() == 1);
+}
+
+// prec: emplace
+void test_table_try_emplace() {
+	tf::hash_table<std::string, std::string> h(1);
+
+	// -- //
+
+	assert(h.try_emplace("One", 3, 'a') == true);
+	assert(h.get("One") == "aaa");
+
+	std::string value = "b";
+	assert(h.try_emplace("One", std::move(value)) == false);
+	assert(h.get("One") == "aaa");
+	assert(value == "b");
+	assert(h.size() == 1);
+
+	for (int i = 0; i < 100; ++i) {
+		assert(h.try_emplace(std::to_string(i), std::to_string(i)) == true);
+	}
+	for (int i = 0; i < 100; ++i) {
+		assert(h.try_emplace(std::to_string(i), "x") == false);
+		assert(h.get(std::to_string(i)) == std::to_string(i));
+	}
+	assert(h.size() == 101);
+}
+
+// prec: try_emplace
+void test_table_insert_or_assign() {
+	tf::hash_table<std::string, std::unique_ptr<int>> h;
+
+	// -- //
+
+	assert(h.insert_or_assign("One", std::unique_ptr<int>(new int(1))) == true);
+	assert(*h.get("One") == 1);
+
+	assert(h.insert_or_assign("One", std::unique_ptr<int>(new int(11))) == false);
+	assert(*h.get("One") == 11);
+	assert(h.size() == 1);
+
+	std::string key = "Two";
+	assert(h.insert_or_assign(key, std::unique_ptr<int>(new int(2))) == true);
+	assert(*h.get("Two") == 2);
+	assert(h.size() == 2);
+}
+
+// prec: insert_or_assign
+void test_table_insert_or_combine() {
+	tf::hash_table<std::string, int> h;
+	auto add = [](int old_value, int value) { return old_value + value; };
+
+	// -- //
+
+	assert(h.insert_or_combine("One", 1, add) == true);
+	assert(h.insert_or_combine("One", 10, add) == false);
+	assert(h.get("One") == 11);
+
+	std::string key = "Two";
+	assert(h.insert_or_combine(key, 2, add) == true);
+	assert(h.insert_or_combine(std::move(key), 2, std::plus<int>()) == false);
+	assert(h.get("Two") == 4);
+	assert(h.size() == 2);
+
+	// the old value is moved into the combine function
+	tf::hash_table<int, std::vector<int>> lists;
+	auto append = [](std::vector<int> list, const std::vector<int> &other) {
+		list.insert(list.end(), other.begin(), other.end());
+		return list;
+	};
+	lists.insert_or_combine(1, std::vector<int>(1, 1), append);
+	lists.insert_or_combine(1, std::vector<int>(2, 2), append);
+	assert(lists.get(1).size() == 3 && lists.get(1)[2] == 2);
+
+	// -- //
+
+	// the hash of another table with the same Hash can be reused
+	tf::hash_table<std::string, int> h2(1);
+	for (auto it = h.begin(); it.has_value(); ++it) {
+		assert(h2.insert_or_combine_hashed(it.key(), it.hash_value(), *it, add) == true);
+	}
+	for (int i = 0; i < 1000; ++i) {
+		std::string number = std::to_string(i);
+		uint64_t hash_value = tf::hasher<std::string>()(number);
+		assert(h2.insert_or_combine_hashed(number, hash_value, 1, add) == true);
+		assert(h2.insert_or_combine_hashed(std::move(number), hash_value, 1, add) == false);
+	}
+	assert(h2.size() == 1002);
+	assert(h2.get("One") == 11);
+	assert(h2.get("999") == 2);
+	assert(h2.insert_or_combine_hashed("Two", tf::hasher<std::string>()("Two"), 1, add) == false);
+	assert(h2.get("Two") == 5);
+}
+
+// prec: get_many
+void test_table_statistics() {
+	tf::hash_table<int, int> h(4);
+	assert(h.tracks_statistics() == false);
+
+	// -- //
+
+	h.insert(0, 0);
+	h.get(0);
+	tf::hash_table_statistics s = h.statistics();
+	assert(s.successful_lookups == 0);
+	assert(s.duplicate_checks == 0);
+	assert(s.chain_lengths.size() == 2);
+	assert(s.chain_lengths[0] == 3 && s.chain_lengths[1] == 1);
+	assert(s.longest_chain == 1);
+	assert(s.empty_buckets == 3);
+
+	h.set_track_statistics(true);
+	assert(h.tracks_statistics() == true);
+	for (int i = 1; i < 100; ++i) {
+		h.insert(i, i);
+	}
+
+	s = h.statistics();
+	assert(s.duplicate_checks == 99);
+	assert(s.rehashes > 0);
+	assert(s.successful_lookups == 0);
+
+	size_t chains = 0;
+	size_t entries = 0;
+	for (size_t length = 0; length < s.chain_lengths.size(); ++length) {
+		chains += s.chain_lengths[length];
+		entries += length * s.chain_lengths[length];
+	}
+	assert(chains == h.table_size() || h.rehashing());
+	assert(entries == 100);
+	assert(s.chain_lengths[s.longest_chain] > 0);
+
+	for (int i = 0; i < 100; ++i) {
+		h.get(i);
+	}
+	assert(h.contains(-1) == false);
+	const int *values[2];
+	int keys[2] = { 1, -2 };
+	h.get_many(keys, 2, values);
+	bool found[2];
+	h.contains_many(keys, 2, found);
+
+	s = h.statistics();
+	assert(s.successful_lookups == 102);
+	assert(s.failed_lookups == 3);
+	assert(s.average_probes_successful >= 1.0);
+	assert(s.average_probes_successful <= s.longest_chain);
+
+	h.reset_statistics();
+	s = h.statistics();
+	assert(s.successful_lookups == 0 && s.failed_lookups == 0 && s.rehashes == 0 && s.duplicate_checks == 0);
+	assert(s.average_probes_failed == 0.0);
+}
+
+// prec: growth
+void test_table_key_types() {
+	// -- //
+
+	assert(tf::hash<int>(1) != tf::hash<int>(2));
+	assert(tf::hash<int>(-1) == tf::hash<long long>(-1));
+	assert(tf::hash<double>(0.0) == tf::hash<double>(-0.0));
+	assert(tf::hash<float>(1.5f) != tf::hash<float>(-1.5f));
+
+	tf::hash_table<int, int> ints(1);
+	for (int i = -500; i < 500; ++i) {
+		ints.insert(i, i);
+	}
+	for (int i = -500; i < 500; ++i) {
+		assert(ints.get(i) == i);
+	}
+
+	tf::hash_table<double, int> doubles;
+	doubles.insert(0.0, 1);
+	assert(doubles.get(-0.0) == 1);
+
+	tf::hash_table<table_assert_color, int> colors;
+	colors.insert(table_assert_color::red, 1);
+	colors.insert(table_assert_color::green, 2);
+	assert(colors.get(table_assert_color::green) == 2);
+
+	int values[2] = { 0, 0 };
+	tf::hash_table<int *, int> pointers;
+	pointers.insert(&values[0], 0);
+	pointers.insert(&values[1], 1);
+	assert(pointers.get(&values[1]) == 1);
+
+	tf::hash_table<table_assert_point, int> points;
+	points.insert({ 1, 2 }, 12);
+	points.insert({ 2, 1 }, 21);
+	assert(points.get({ 1, 2 }) == 12);
+	assert(points.get({ 2, 1 }) == 21);
+
+	tf::hash_table<table_assert_record, int> records;
+	table_assert_record r1;
+	table_assert_record r2;
+	std::memset(&r1, 0xAA, sizeof(r1));
+	std::memset(&r2, 0x55, sizeof(r2));
+	r1.type = r2.type = 'a';
+	r1.id = r2.id = 7;
+	records.insert(r1, 7);
+	assert(records.get(r2) == 7);
+}
+
+// prec: remove, growth
+void test_table_multimap() {
+	tf::hash_table<int, int> h(1, true, true);
+	assert(h.allows_duplicate_keys() == true);
+	assert(h.checks_duplicate_keys() == false);
+
+	// -- //
+
+	// equal keys stay grouped while the table grows (and migrates) underneath them
+	for (int i = 0; i < 1000; ++i) {
+		h.insert(i % 100, i);
+	}
+	assert(h.size() == 1000);
+	assert(h.table_size() > 1);
+
+	for (int key = 0; key < 100; ++key) {
+		assert(h.count(key) == 10);
+
+		int sum = 0;
+		int num_values = 0;
+		for (auto it = h.equal_range(key); it.has_value(); ++it) {
+			assert(it.key() == key);
+			assert(*it % 100 == key);
+			sum += it.value();
+			++num_values;
+		}
+		assert(num_values == 10);
+		assert(sum == 10 * key + 100 * 45);
+	}
+
+	assert(h.count(100) == 0);
+	assert(h.equal_range(100).has_value() == false);
+
+	const tf::hash_table<int, int> &c = h;
+	int num_values = 0;
+	for (auto it = c.equal_range(7); it.has_value(); ++it) {
+		++num_values;
+	}
+	assert(num_values == 10);
+
+	// remove only takes one of the values
+	assert(h.remove(7) % 100 == 7);
+	assert(h.count(7) == 9);
+
+	assert(h.remove_all(7) == 9);
+	assert(h.contains(7) == false);
+	assert(h.size() == 990);
+	assert(h.count(6) == 10 && h.count(8) == 10);
+
+	try {
+		h.remove_all(7);
+		assert(false);
+	} catch (tf::exception &) {}
+
+	tf::hash_table<int, int> copy(h);
+	assert(copy.allows_duplicate_keys() == true);
+	for (int key = 0; key < 100; ++key) {
+		assert(copy.count(key) == ((key == 7) ? 0 : 10));
+	}
+
+	// a table without the flag still throws
+	tf::hash_table<int, int> unique;
+	unique.insert(1, 1);
+	assert(unique.count(1) == 1);
+	try {
+		unique.insert(1, 2);
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: multimap
+void test_table_insert_many() {
+	std::vector<std::pair<int, int>> pairs;
+	for (int i = 0; i < 20000; ++i) {
+		pairs.push_back(std::make_pair(i, i * 2));
+	}
+
+	// -- //
+
+	tf::hash_table<int, int> h;
+	h.insert(-1, -1);
+	h.insert_many(pairs.begin(), pairs.end(), 4);
+	assert(h.size() == 20001);
+	assert(h.load_factor() <= h.max_load_factor());
+	assert(h.get(-1) == -1);
+	for (int i = 0; i < 20000; ++i) {
+		assert(h.get(i) == i * 2);
+	}
+
+	h.insert_many(pairs.begin(), pairs.begin());
+	assert(h.size() == 20001);
+
+	// one thread and more threads than pairs
+	tf::hash_table<int, int> h2;
+	h2.insert_many(pairs.begin(), pairs.begin() + 100, 1);
+	h2.insert_many(pairs.begin() + 100, pairs.begin() + 200, 64);
+	assert(h2.size() == 200);
+	for (int i = 0; i < 200; ++i) {
+		assert(h2.get(i) == i * 2);
+	}
+
+	// existing keys throw, the table keeps the pairs that were inserted
+	std::vector<std::pair<int, int>> overlapping;
+	for (int i = 15000; i < 25000; ++i) {
+		overlapping.push_back(std::make_pair(i, i));
+	}
+
+	try {
+		h.insert_many(overlapping.begin(), overlapping.end(), 2);
+		assert(false);
+	} catch (tf::exception &) {}
+	assert(h.size() >= 20001 && h.size() <= 25001);
+	for (int i = 0; i < 20000; ++i) {
+		assert(h.get(i) == i * 2);
+	}
+
+	// duplicate keys inside the input are grouped in a multimap
+	tf::hash_table<int, int> m(100, true, true);
+	m.insert(1, 0);
+	for (int i = 0; i < 20000; ++i) {
+		pairs[i].first = i % 10;
+	}
+	m.insert_many(pairs.begin(), pairs.end(), 4);
+	assert(m.size() == 20001);
+	assert(m.count(1) == 2001);
+	assert(m.count(2) == 2000);
+	assert(m.remove_all(1) == 2001);
+
+	// values are moved with move iterators
+	std::vector<std::pair<std::string, std::unique_ptr<int>>> owned;
+	for (int i = 0; i < 10000; ++i) {
+		owned.push_back(std::make_pair(std::to_string(i), std::unique_ptr<int>(new int(i))));
+	}
+
+	tf::hash_table<std::string, std::unique_ptr<int>> u;
+	u.insert_many(std::make_move_iterator(owned.begin()), std::make_move_iterator(owned.end()), 2);
+	assert(u.size() == 10000);
+	assert(*u.get("1234") == 1234);
+	assert(owned[1234].second == nullptr);
+}
+
+// prec: iteration, growth, insert_many
+void test_table_insertion_order() {
+	tf::hash_table<int, int> h(1);
+	for (int i = 0; i < 1000; ++i) {
+		h.insert(i * 7, i);
+	}
+
+	// -- //
+
+	// the order survives growing, removing and reinserting
+	for (int i = 0; i < 1000; i += 2) {
+		h.remove(i * 7);
+	}
+	h.insert(-1, -1);
+
+	int expected = 1;
+	for (auto it = h.begin(); it.has_value(); ++it) {
+		if (expected < 1000) {
+			assert(it.key() == expected * 7 && *it == expected);
+			expected += 2;
+		}
+		else {
+			assert(it.key() == -1);
+			expected = -1;
+		}
+	}
+	assert(expected == -1);
+
+	h.rehash(5000);
+	tf::hash_table<int, int> copy(h);
+	const tf::hash_table<int, int> &c = copy;
+	auto it = h.begin();
+	for (auto copy_it = c.begin(); copy_it.has_value(); ++copy_it, ++it) {
+		assert(it.has_value() && it.key() == copy_it.key());
+	}
+	assert(!it.has_value());
+
+	// sparse table after removing almost everything
+	for (int i = 1; i < 999; i += 2) {
+		h.remove(i * 7);
+	}
+	it = h.begin();
+	assert(it.key() == 999 * 7);
+	++it;
+	assert(it.key() == -1);
+	++it;
+	assert(!it.has_value());
+
+	h.clear();
+	assert(!h.begin().has_value());
+	h.insert(3, 3);
+	assert(h.begin().key() == 3);
+
+	// insert_many keeps the order of the range
+	std::vector<std::pair<int, int>> pairs;
+	for (int i = 0; i < 20000; ++i) {
+		pairs.push_back(std::make_pair(static_cast<int>(i * 2654435761U), i));
+	}
+
+	tf::hash_table<int, int> bulk;
+	bulk.insert_many(pairs.begin(), pairs.end(), 4);
+	int i = 0;
+	for (auto bulk_it = bulk.begin(); bulk_it.has_value(); ++bulk_it, ++i) {
+		assert(*bulk_it == i);
+	}
+	assert(i == 20000);
+}
+
+// prec: statistics, insert_many
+void test_table_bloom_filter() {
+	tf::hash_table<int, int> h(16);
+	assert(h.bloom_filter_bits_per_entry() == 0);
+	assert(h.statistics().bloom_filter_bytes == 0);
+
+	// -- //
+
+	for (int i = 0; i < 100; ++i) {
+		h.insert(i, i);
+	}
+
+	h.set_bloom_filter(12);
+	assert(h.bloom_filter_bits_per_entry() == 12);
+	assert(h.statistics().bloom_filter_bytes > 0);
+
+	// the entries are added to a new filter while the table grows, until then lookups also check the old filter
+	int checks_during_migration = 0;
+	for (int i = 100; i < 10000; ++i) {
+		h.insert(i, i);
+		if (h.rehashing()) {
+			assert(h.contains(i) == true);
+			assert(h.contains(i / 2) == true);
+			assert(h.contains(i - 100) == true);
+			++checks_during_migration;
+		}
+	}
+	assert(checks_during_migration > 0);
+	h.set_track_statistics(true);
+
+	for (int i = 0; i < 10000; ++i) {
+		assert(h.contains(i) == true);
+		assert(h.get(i) == i);
+	}
+
+	int misses = 0;
+	for (int i = 10000; i < 20000; ++i) {
+		misses += !h.contains(i);
+	}
+	assert(misses == 10000);
+
+	tf::hash_table_statistics s = h.statistics();
+	assert(s.bloom_filter_checks == 30000);
+	assert(s.bloom_filter_rejections + s.bloom_filter_false_positives == 10000);
+	// about 1% false positives
+	assert(s.bloom_filter_false_positives < 500);
+	assert(s.failed_lookups == 10000);
+
+	// removed keys stay in the filter until it is rebuilt, but are not found
+	for (int i = 0; i < 10000; i += 2) {
+		h.remove(i);
+	}
+	for (int i = 0; i < 10000; ++i) {
+		assert(h.contains(i) == (i % 2 == 1));
+	}
+
+	const int *values[4];
+	int keys[4] = { 1, 2, 3, 20001 };
+	assert(h.get_many(keys, 4, values) == 2);
+	assert(*values[0] == 1 && values[1] == nullptr && *values[2] == 3 && values[3] == nullptr);
+
+	// batch lookups count the filter checks, rejections and false positives like single lookups
+	std::vector<int> missing_keys;
+	for (int i = 20000; i < 30000; ++i) {
+		missing_keys.push_back(i);
+	}
+	bool *results = new bool[missing_keys.size()];
+	h.reset_statistics();
+	assert(h.contains_many(missing_keys.data(), missing_keys.size(), results) == 0);
+	delete[] results;
+
+	s = h.statistics();
+	assert(s.bloom_filter_checks == 10000);
+	assert(s.failed_lookups == 10000);
+	assert(s.bloom_filter_rejections + s.bloom_filter_false_positives == 10000);
+	assert(s.bloom_filter_false_positives > 0 && s.bloom_filter_false_positives < 500);
+
+	h.shrink_to_fit();
+	tf::hash_table<int, int> copy(h);
+	assert(copy.bloom_filter_bits_per_entry() == 12);
+	for (int i = 0; i < 10000; ++i) {
+		assert(copy.contains(i) == (i % 2 == 1));
+	}
+
+	// insert_many adds its keys to the filter
+	std::vector<std::pair<int, int>> pairs;
+	for (int i = 20000; i < 40000; ++i) {
+		pairs.push_back(std::make_pair(i, i));
+	}
+	copy.insert_many(pairs.begin(), pairs.end(), 2);
+	for (int i = 20000; i < 40000; ++i) {
+		assert(copy.get(i) == i);
+	}
+
+	copy.clear();
+	assert(copy.contains(1) == false);
+	copy.insert(1, 1);
+	assert(copy.contains(1) == true);
+
+	h.set_bloom_filter(0);
+	assert(h.statistics().bloom_filter_bytes == 0);
+	assert(h.contains(1) == true && h.contains(2) == false);
+}
@@ -0,0 +1,165 @@
+#include <cassert>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include "../../tfds/tf_hash_table_view.hpp"
+
+void test_table_view();
+void test_table_view_int_keys();
+void test_table_view_string_keys();
+void test_table_view_empty();
+void test_table_view_move_constructor();
+void test_table_view_invalid_file();
+
+
+/* int main(int argc, char *argv[]) {
+	test_table_view();
+
+	return 0;
+} */
+
+void test_table_view() {
+	test_table_view_int_keys();
+	test_table_view_string_keys();
+	test_table_view_empty();
+	test_table_view_move_constructor();
+	test_table_view_invalid_file();
+
+	std::cout << "HASH TABLE VIEW tests successful." << std::endl;
+}
+
+// prec: -
+void test_table_view_int_keys() {
+	const char *path = "hash_table_view_assert.snapshot";
+	tf::hash_table<int, double> h(1);
+	for (int i = 0; i < 1000; ++i) {
+		h.insert(i * 3, i / 2.0);
+	}
+
+	// -- //
+
+	tf::write_snapshot(h, path);
+	tf::hash_table_view<int, double> v(path);
+	assert(v.size() == 1000);
+	assert(v.table_size() == 1000);
+	assert(v.empty() == false);
+
+	for (int i = 0; i < 1000; ++i) {
+		assert(v.get(i * 3) == i / 2.0);
+		assert(v[i * 3] == i / 2.0);
+		assert(v.contains(i * 3) == true);
+		assert(v.contains(i * 3 + 1) == false);
+	}
+
+	try {
+		v.get(1);
+		assert(false);
+	} catch (tf::exception &) {}
+
+	std::remove(path);
+}
+
+// prec: int_keys
+void test_table_view_string_keys() {
+	const char *path = "hash_table_view_assert.snapshot";
+	tf::hash_table<std::string, int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+	h.insert("", 0);
+	h.insert(std::string(1000, 'x'), 1000);
+
+	// -- //
+
+	tf::write_snapshot(h, path);
+	tf::hash_table_view<std::string, int> v(path);
+	assert(v.size() == 4);
+
+	assert(v.get("One") == 1);
+	assert(v.get(std::string("Two")) == 2);
+	assert(v.get(std::string_view("Two!", 3)) == 2);
+	assert(v.get("") == 0);
+	assert(v.get(std::string(1000, 'x')) == 1000);
+	assert(v.contains("Three") == false);
+	assert(v.contains("On") == false);
+
+	std::remove(path);
+}
+
+// prec: int_keys
+void test_table_view_empty() {
+	const char *path = "hash_table_view_assert.snapshot";
+	tf::hash_table<int, int> h;
+
+	// -- //
+
+	tf::write_snapshot(h, path);
+	tf::hash_table_view<int, int> v(path);
+	assert(v.size() == 0);
+	assert(v.empty() == true);
+	assert(v.contains(0) == false);
+
+	std::remove(path);
+}
+
+// prec: int_keys
+void test_table_view_move_constructor() {
+	const char *path = "hash_table_view_assert.snapshot";
+	tf::hash_table<int, int> h;
+	h.insert(1, 10);
+	tf::write_snapshot(h, path);
+	tf::hash_table_view<int, int> v(path);
+
+	// -- //
+
+	tf::hash_table_view<int, int> v2(std::move(v));
+	assert(v2.get(1) == 10);
+	assert(v.size() == 0);
+
+	std::remove(path);
+}
+
+// prec: int_keys
+void test_table_view_invalid_file() {
+	const char *path = "hash_table_view_assert.snapshot";
+
+	// -- //
+
+	try {
+		tf::hash_table_view<int, int> v("hash_table_view_assert.missing");
+		assert(false);
+	} catch (tf::exception &) {}
+
+	{
+		std::ofstream file(path, std::ios::binary);
+		file << "not a snapshot, but long enough to contain a whole header of a snapshot file.........";
+	}
+	try {
+		tf::hash_table_view<int, int> v(path);
+		assert(false);
+	} catch (tf::exception &) {}
+
+	// different value type
+	tf::hash_table<int, int> h;
+	h.insert(1, 1);
+	tf::write_snapshot(h, path);
+	try {
+		tf::hash_table_view<int, double> v(path);
+		assert(false);
+	} catch (tf::exception &) {}
+
+	// truncated
+	std::ifstream in(path, std::ios::binary);
+	std::string image((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	in.close();
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(image.data(), image.size() / 2);
+	}
+	try {
+		tf::hash_table_view<int, int> v(path);
+		assert(false);
+	} catch (tf::exception &) {}
+
+	std::remove(path);
+}
@@ -1,5 +1,12 @@
 #include <cassert>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <iterator>
 #include "../../tfds/tf_search_tree.hpp"
 
 void test_tree();
@@ -23,6 +30,22 @@ void test_tree_remove_value();
 void test_tree_iteration();
 void test_tree_empty();
 void test_tree_clear();
+void test_tree_lookup_key();
+void test_tree_find();
+void test_tree_bounds();
+void test_tree_range();
+void test_tree_rank();
+void test_tree_select();
+void test_tree_count_range();
+void test_tree_percentile();
+void test_tree_order_statistics();
+void test_tree_bulk_load();
+void test_tree_insert_many();
+void test_tree_duplicate_order();
+void test_tree_unite();
+void test_tree_intersect();
+void test_tree_subtract();
+void test_tree_split_at();
 
 
 /* int main(int argc, char *argv[]) {
@@ -52,6 +75,22 @@ void test_tree() {
 	test_tree_iteration();
 	test_tree_empty();
 	test_tree_clear();
+	test_tree_lookup_key();
+	test_tree_find();
+	test_tree_bounds();
+	test_tree_range();
+	test_tree_rank();
+	test_tree_select();
+	test_tree_count_range();
+	test_tree_percentile();
+	test_tree_order_statistics();
+	test_tree_bulk_load();
+	test_tree_insert_many();
+	test_tree_duplicate_order();
+	test_tree_unite();
+	test_tree_intersect();
+	test_tree_subtract();
+	test_tree_split_at();
 
 	std::cout << "SEARCH TREE tests successful." << std::endl;
 }
@@ -154,6 +193,24 @@ void test_tree_copy_constructor() {
 
 	t2.insert(2, "Two2");
 	assert(t.size() == 4);
+
+	// the copy has the same structure and keeps the order of values with equal keys
+	t.insert(5, "Five2");
+	t.insert(5, "Five3");
+	tf::search_tree<int, std::string> t3(t);
+	assert(t3.size() == 6);
+	assert(t3.height() == t.height());
+	assert(t3.rank(6) == 4);
+	for (auto it = t.begin(), it3 = t3.begin(); it.has_value(); ++it, ++it3) {
+		assert(it3.has_value() == true);
+		assert(it.key() == it3.key());
+		assert(*it == *it3);
+	}
+
+	tf::search_tree<int, std::string> empty;
+	tf::search_tree<int, std::string> t4(empty);
+	assert(t4.size() == 0);
+	assert(t4.empty() == true);
 }
 
 // prec: get
@@ -658,4 +715,759 @@ void test_tree_clear() {
 		t.min();
 		assert(false);
 	} catch (tf::exception &) {}
-}
\ No newline at end of file
+}
+// prec: remove, brackets_operator
+void test_tree_lookup_key() {
+	tf::search_tree<std::string, int> t(true);
+	t.insert("b", 2);
+	t.insert("a", 1);
+	t.insert("c", 3);
+	t.insert("c", 33);
+	t.insert("ab", 12);
+
+	// -- //
+
+	std::string buffer = "abc";
+	std::string_view a(buffer.data(), 1);
+	std::string_view ab(buffer.data(), 2);
+	const char *c = "c";
+
+	assert(t.get(a) == 1);
+	assert(t.get(ab) == 12);
+	assert(t.get("b") == 2);
+	assert(t.contains(c) == true);
+	assert(t.contains(std::string_view(buffer.data() + 1, 2)) == false);
+
+	t[ab] = 120;
+	assert(t.get("ab") == 120);
+	const tf::search_tree<std::string, int> &const_t = t;
+	assert(const_t[a] == 1);
+
+	assert(t.remove(c) == 3);
+	assert(t.remove(c) == 33);
+	assert(t.contains(c) == false);
+	assert(t.size() == 3);
+
+	try {
+		t.get(std::string_view("d"));
+		assert(false);
+	} catch (tf::exception &) {}
+
+	try {
+		t.remove(c);
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: insert, iteration
+void test_tree_find() {
+	tf::search_tree<int, std::string> t(true);
+	t.insert(1, "One");
+	t.insert(5, "Five");
+	t.insert(5, "Five2");
+	t.insert(9, "Nine");
+
+	const tf::search_tree<int, std::string> &const_t = t;
+
+	// -- //
+
+	auto it = t.find(5);
+	assert(it.has_value() == true);
+	assert(it.key() == 5);
+	assert(*it == "Five" || *it == "Five2");
+	++it;
+	assert(*it == "Five" || *it == "Five2");
+	++it;
+	assert(it.key() == 9);
+	++it;
+	assert(it.has_value() == false);
+
+	it = t.find(5);
+	--it;
+	--it;
+	assert(it.key() == 1);
+
+	it = t.find(9);
+	it.value() = "New Nine";
+	assert(t.get(9) == "New Nine");
+
+	assert(t.find(4).has_value() == false);
+	assert(const_t.find(1).value() == "One");
+	assert(const_t.find(10).has_value() == false);
+
+	tf::search_tree<std::string, int> t2;
+	t2.insert("a", 1);
+	t2.insert("b", 2);
+	assert(*t2.find(std::string_view("b")) == 2);
+	assert(t2.find("c").has_value() == false);
+}
+
+// prec: insert, iteration
+void test_tree_bounds() {
+	tf::search_tree<int, int> t;
+	for (int i = 0; i < 100; i += 10) {
+		t.insert(i, i);
+	}
+
+	const tf::search_tree<int, int> &const_t = t;
+
+	// -- //
+
+	assert(t.lower_bound(-5).key() == 0);
+	assert(t.lower_bound(0).key() == 0);
+	assert(t.lower_bound(1).key() == 10);
+	assert(t.lower_bound(90).key() == 90);
+	assert(t.lower_bound(91).has_value() == false);
+
+	assert(t.upper_bound(-5).key() == 0);
+	assert(t.upper_bound(0).key() == 10);
+	assert(t.upper_bound(15).key() == 20);
+	assert(t.upper_bound(90).has_value() == false);
+
+	assert(const_t.lower_bound(35).key() == 40);
+	assert(const_t.upper_bound(40).key() == 50);
+
+	// the iterators are not limited
+	int count = 0;
+	for (auto it = t.lower_bound(45); it.has_value(); ++it) {
+		++count;
+	}
+	assert(count == 5);
+
+	for (auto it = t.upper_bound(45); it.has_value(); --it) {
+		++count;
+	}
+	assert(count == 11);
+
+	tf::search_tree<int, int> empty;
+	assert(empty.lower_bound(1).has_value() == false);
+	assert(empty.upper_bound(1).has_value() == false);
+}
+
+// prec: insert, iteration, remove
+void test_tree_range() {
+	tf::search_tree<int, int> t(true);
+	for (int i = 0; i < 1000; ++i) {
+		t.insert(i, i);
+	}
+	t.insert(500, -500);
+
+	const tf::search_tree<int, int> &const_t = t;
+
+	// -- //
+
+	int expected = 100;
+	for (auto it = t.range(100, 200); it.has_value(); ++it) {
+		assert(it.key() == expected);
+		++expected;
+	}
+	assert(expected == 200);
+
+	for (auto it = t.range(100, 200); it.has_value(); --it) {
+		--expected;
+	}
+	assert(expected == 199);
+
+	int count = 0;
+	for (auto it = t.range(499, 502); it.has_value(); ++it) {
+		++count;
+	}
+	assert(count == 4);
+
+	count = 0;
+	for (auto it = const_t.range(-10, 3); it.has_value(); ++it) {
+		++count;
+	}
+	assert(count == 3);
+
+	count = 0;
+	for (auto it = t.range(995, 2000); it.has_value(); ++it) {
+		it.value() = 0;
+		++count;
+	}
+	assert(count == 5);
+	assert(t.get(999) == 0);
+
+	assert(t.range(5, 5).has_value() == false);
+	assert(t.range(6, 5).has_value() == false);
+	assert(t.range(1000, 2000).has_value() == false);
+	assert(t.range(-2000, 0).has_value() == false);
+
+	for (int i = 0; i < 1000; i += 2) {
+		t.remove(i);
+	}
+
+	count = 0;
+	for (auto it = t.range(10, 20); it.has_value(); ++it) {
+		assert(it.key() % 2 == 1);
+		++count;
+	}
+	assert(count == 5);
+
+	tf::search_tree<std::string, int> t2;
+	t2.insert("a", 1);
+	t2.insert("ab", 2);
+	t2.insert("b", 3);
+	t2.insert("c", 4);
+
+	count = 0;
+	for (auto it = t2.range(std::string_view("a"), std::string_view("b")); it.has_value(); ++it) {
+		++count;
+	}
+	assert(count == 2);
+}
+
+// prec: insert, remove, remove_value
+void test_tree_rank() {
+	tf::search_tree<int, int> t(true);
+
+	// -- //
+
+	assert(t.rank(5) == 0);
+
+	for (int i = 0; i < 100; i += 10) {
+		t.insert(i, i);
+	}
+	t.insert(50, 51);
+	t.insert(50, 52);
+
+	assert(t.rank(-1) == 0);
+	assert(t.rank(0) == 0);
+	assert(t.rank(1) == 1);
+	assert(t.rank(50) == 5);
+	assert(t.rank(51) == 8);
+	assert(t.rank(1000) == 12);
+
+	t.remove(50);
+	assert(t.rank(51) == 7);
+	t.remove_value(50, 51);
+	assert(t.rank(51) == 6);
+	t.remove(0);
+	assert(t.rank(51) == 5);
+
+	tf::search_tree<std::string, int> t2;
+	t2.insert("a", 1);
+	t2.insert("b", 2);
+	assert(t2.rank(std::string_view("b")) == 1);
+}
+
+// prec: insert, remove
+void test_tree_select() {
+	tf::search_tree<int, int> t(true);
+	for (int i = 9; i >= 0; --i) {
+		t.insert(i * 10, i);
+	}
+	t.insert(50, 55);
+
+	const tf::search_tree<int, int> &const_t = t;
+
+	// -- //
+
+	assert(t.select(0).key() == 0);
+	assert(t.select(4).key() == 40);
+	assert(t.select(5).key() == 50);
+	assert(t.select(6).key() == 50);
+	assert(*t.select(5) != *t.select(6));
+	assert(t.select(7).key() == 60);
+	assert(const_t.select(10).key() == 90);
+
+	auto it = t.select(8);
+	++it;
+	assert(it.key() == 80);
+
+	try {
+		t.select(11);
+		assert(false);
+	} catch (tf::exception &) {}
+
+	t.remove(0);
+	assert(t.select(0).key() == 10);
+}
+
+// prec: insert
+void test_tree_count_range() {
+	tf::search_tree<int, int> t(true);
+	for (int i = 0; i < 1000; ++i) {
+		t.insert(i, i);
+	}
+	t.insert(500, 500);
+
+	// -- //
+
+	assert(t.count_range(0, 1000) == 1001);
+	assert(t.count_range(100, 200) == 100);
+	assert(t.count_range(500, 501) == 2);
+	assert(t.count_range(-100, 10) == 10);
+	assert(t.count_range(990, 2000) == 10);
+	assert(t.count_range(5, 5) == 0);
+	assert(t.count_range(6, 5) == 0);
+}
+
+// prec: insert
+void test_tree_percentile() {
+	tf::search_tree<int, int> t(true);
+
+	// -- //
+
+	try {
+		t.percentile(50);
+		assert(false);
+	} catch (tf::exception &) {}
+
+	for (int i = 1; i <= 100; ++i) {
+		t.insert(i, i);
+	}
+
+	assert(t.percentile(0).key() == 1);
+	assert(t.percentile(1).key() == 1);
+	assert(t.percentile(50).key() == 50);
+	assert(t.percentile(99).key() == 99);
+	assert(t.percentile(99.5).key() == 100);
+	assert(t.percentile(100).key() == 100);
+
+	try {
+		t.percentile(101);
+		assert(false);
+	} catch (tf::exception &) {}
+
+	try {
+		t.percentile(-1);
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: rank, select, count_range
+void test_tree_order_statistics() {
+	tf::search_tree<int, int> t(true);
+	std::vector<int> expected;
+	std::mt19937 generator(7);
+	std::uniform_int_distribution<int> keys(0, 500);
+
+	// -- //
+
+	// the counts stay correct during rotations and removals
+	for (int i = 0; i < 20000; ++i) {
+		int key = keys(generator);
+		auto position = std::lower_bound(expected.begin(), expected.end(), key);
+		if (generator() % 3 == 0 && position != expected.end() && *position == key) {
+			if (generator() % 2 == 0) {
+				t.remove(key);
+				expected.erase(position);
+			}
+			else {
+				t.remove_all(key);
+				expected.erase(position, std::upper_bound(position, expected.end(), key));
+			}
+		}
+		else {
+			t.insert(key, key);
+			expected.insert(position, key);
+		}
+
+		if (i % 97 == 0) {
+			assert(t.size() == expected.size());
+			for (int k = -1; k <= 501; k += 13) {
+				size_t rank = std::lower_bound(expected.begin(), expected.end(), k) - expected.begin();
+				assert(t.rank(k) == rank);
+			}
+
+			for (size_t j = 0; j < expected.size(); j += 11) {
+				assert(t.select(j).key() == expected[j]);
+			}
+		}
+	}
+}
+
+// prec: insert, iteration, select
+void test_tree_bulk_load() {
+	std::vector<std::pair<int, std::string>> pairs;
+	for (int i = 0; i < 1000; ++i) {
+		pairs.emplace_back(i, std::to_string(i));
+	}
+
+	// -- //
+
+	tf::search_tree<int, std::string> t(pairs.begin(), pairs.end());
+	assert(t.size() == 1000);
+	assert(t.height() == 10);
+	assert(t.allows_duplicate_keys() == false);
+	for (int i = 0; i < 1000; ++i) {
+		assert(t.get(i) == std::to_string(i));
+	}
+	assert(t.select(500).key() == 500);
+
+	// the tree is balanced after further insertions and removals
+	for (int i = 1000; i < 1100; ++i) {
+		t.insert(i, std::to_string(i));
+	}
+	for (int i = 0; i < 500; ++i) {
+		t.remove(i);
+	}
+	assert(t.size() == 600);
+	assert(t.height() <= 10);
+
+	std::vector<std::pair<int, std::string>> empty_pairs;
+	tf::search_tree<int, std::string> empty(empty_pairs.begin(), empty_pairs.end());
+	assert(empty.empty() == true);
+
+	std::vector<std::pair<int, std::string>> duplicate_pairs = { {1, "One"}, {2, "Two"}, {2, "Two2"}, {2, "Two3"}, {3, "Three"} };
+	tf::search_tree<int, std::string> t2(duplicate_pairs.begin(), duplicate_pairs.end(), true);
+	assert(t2.size() == 5);
+	assert(t2.height() == 2);
+	assert(t2.count_range(2, 3) == 3);
+	assert(t2.rank(3) == 4);
+
+	int i = 0;
+	for (auto it = t2.begin(); it.has_value(); ++it) {
+		assert(*it == duplicate_pairs[i].second);
+		++i;
+	}
+	assert(i == 5);
+
+	try {
+		tf::search_tree<int, std::string> t3(duplicate_pairs.begin(), duplicate_pairs.end());
+		assert(false);
+	} catch (tf::exception &) {}
+
+	std::vector<std::pair<int, std::string>> unsorted_pairs = { {1, "One"}, {3, "Three"}, {2, "Two"} };
+	try {
+		tf::search_tree<int, std::string> t3(unsorted_pairs.begin(), unsorted_pairs.end(), true);
+		assert(false);
+	} catch (tf::exception &) {}
+
+	tf::search_tree<int, std::string> t4(std::make_move_iterator(pairs.begin()), std::make_move_iterator(pairs.end()));
+	assert(t4.get(999) == "999");
+}
+
+// prec: bulk_load, insert
+void test_tree_insert_many() {
+	std::vector<std::pair<int, int>> pairs;
+	for (int i = 0; i < 20000; ++i) {
+		pairs.emplace_back((i * 7919) % 20000, i);
+	}
+
+	// -- //
+
+	tf::search_tree<int, int> t;
+	t.insert_many(pairs.begin(), pairs.end(), 4);
+	assert(t.size() == 20000);
+	assert(t.height() == 15);
+
+	int expected = 0;
+	for (auto it = t.begin(); it.has_value(); ++it) {
+		assert(it.key() == expected);
+		assert(*it * 7919 % 20000 == expected);
+		++expected;
+	}
+	assert(expected == 20000);
+
+	// merged with the entries of the tree
+	std::vector<std::pair<int, int>> more_pairs = { {-5, -5}, {30000, 30000}, {-1, -1} };
+	t.insert_many(more_pairs.begin(), more_pairs.end());
+	assert(t.size() == 20003);
+	assert(t.select(0).key() == -5);
+	assert(t.select(1).key() == -1);
+	assert(t.select(2).key() == 0);
+	assert(t.max() == 30000);
+
+	// the tree is not changed if a key exists
+	std::vector<std::pair<int, int>> existing_pairs = { {-100, 0}, {5, 5} };
+	try {
+		t.insert_many(existing_pairs.begin(), existing_pairs.end());
+		assert(false);
+	} catch (tf::exception &) {}
+	assert(t.size() == 20003);
+	assert(t.contains(-100) == false);
+
+	tf::search_tree<int, int> t2(true);
+	t2.insert(5, 1);
+	t2.insert_many(existing_pairs.begin(), existing_pairs.end());
+	t2.insert_many(existing_pairs.begin(), existing_pairs.end(), 1);
+	assert(t2.size() == 5);
+	assert(t2.count_range(5, 6) == 3);
+	assert(t2.contains_value(5, 1) == true);
+
+	std::vector<std::pair<int, int>> no_pairs;
+	t2.insert_many(no_pairs.begin(), no_pairs.end());
+	assert(t2.size() == 5);
+}
+
+// prec: bulk_load, insert_many, remove_value
+void test_tree_duplicate_order() {
+	// 100 keys with 200 values each, the values count up in input order
+	std::vector<std::pair<int, int>> pairs;
+	for (int i = 0; i < 20000; ++i) {
+		pairs.emplace_back((i * 7919) % 100, i);
+	}
+
+	std::vector<std::pair<int, int>> sorted_pairs = pairs;
+	std::stable_sort(sorted_pairs.begin(), sorted_pairs.end(), [](const std::pair<int, int> &a, const std::pair<int, int> &b) {
+		return a.first < b.first;
+	});
+
+	// -- //
+
+	tf::search_tree<int, int> inserted(true);
+	for (const std::pair<int, int> &pair : pairs) {
+		inserted.insert(pair.first, pair.second);
+	}
+
+	tf::search_tree<int, int> inserted_many(true);
+	inserted_many.insert_many(pairs.begin(), pairs.end(), 4);
+
+	tf::search_tree<int, int> bulk_loaded(sorted_pairs.begin(), sorted_pairs.end(), true);
+
+	// all paths iterate over the values of a key in input order
+	auto it = inserted.begin();
+	auto many_it = inserted_many.begin();
+	auto bulk_it = bulk_loaded.begin();
+	for (const std::pair<int, int> &pair : sorted_pairs) {
+		assert(it.key() == pair.first && *it == pair.second);
+		assert(many_it.key() == pair.first && *many_it == pair.second);
+		assert(bulk_it.key() == pair.first && *bulk_it == pair.second);
+		++it;
+		++many_it;
+		++bulk_it;
+	}
+	assert(it.has_value() == false);
+	assert(many_it.has_value() == false);
+	assert(bulk_it.has_value() == false);
+
+	// -- //
+
+	// values added later go behind the existing ones on every path
+	tf::search_tree<int, int> t(true);
+	t.insert(1, 10);
+	t.insert(1, 11);
+	std::vector<std::pair<int, int>> more_pairs = { {1, 12}, {2, 20}, {1, 13} };
+	t.insert_many(more_pairs.begin(), more_pairs.end());
+	t.insert(1, 14);
+
+	tf::search_tree<int, int> t2(true);
+	t2.insert(1, 15);
+	t.unite(t2);
+	t.insert(1, 16);
+
+	int expected = 10;
+	for (auto it = t.find(1); it.has_value() && it.key() == 1; ++it) {
+		assert(*it == expected);
+		++expected;
+	}
+	assert(expected == 17);
+	assert(t.get(1) == 10);
+
+	// removing the last value keeps appending at the end
+	assert(t.remove_value(1, 16) == 16);
+	t.insert(1, 17);
+	assert(t.remove(1) == 10);
+
+	expected = 11;
+	for (auto it = t.find(1); it.has_value() && it.key() == 1; ++it) {
+		assert(*it == ((expected == 16) ? 17 : expected));
+		++expected;
+	}
+	assert(expected == 17);
+
+	// the values move with their key when a node with two children is removed
+	tf::search_tree<int, int> t3(true);
+	for (int i = 0; i < 100; ++i) {
+		t3.insert(i, i);
+	}
+	t3.insert(64, 640);
+	t3.remove(63);
+	t3.remove_all(31);
+	t3.insert(64, 641);
+	t3.insert(32, 320);
+
+	expected = 0;
+	for (auto it = t3.find(64); it.has_value() && it.key() == 64; ++it) {
+		assert(*it == ((expected == 0) ? 64 : 639 + expected));
+		++expected;
+	}
+	assert(expected == 3);
+	assert(t3.count_range(32, 33) == 2);
+	assert(t3.select(31).value() == 32);
+	assert(t3.select(32).value() == 320);
+}
+
+// prec: insert, iteration, select
+void test_tree_unite() {
+	tf::search_tree<int, int> t;
+	tf::search_tree<int, int> t2;
+	for (int i = 0; i < 50000; i += 2) {
+		t.insert(i, i);
+	}
+	for (int i = 0; i < 50000; i += 3) {
+		t2.insert(i, -i);
+	}
+
+	// -- //
+
+	// the subtrees are merged on several threads
+	t.unite(t2, 4);
+	assert(t.size() == 25000 + 16667 - 8334);
+	assert(t2.size() == 16667);
+	assert(t.height() <= 18);
+
+	int expected = 0;
+	for (auto it = t.begin(); it.has_value(); ++it) {
+		while (expected % 2 != 0 && expected % 3 != 0) {
+			++expected;
+		}
+		assert(it.key() == expected);
+		assert(*it == ((expected % 2 == 0) ? expected : -expected));
+		++expected;
+	}
+	assert(t.select(3).key() == 4);
+	assert(t.rank(10) == 7);
+
+	tf::search_tree<int, int> t3;
+	t3.insert(-1, -1);
+	t3.insert(100000, 100000);
+	t.unite(std::move(t3));
+	assert(t.min() == -1);
+	assert(t.max() == 100000);
+	assert(t3.size() == 0);
+
+	tf::search_tree<int, int> empty;
+	empty.unite(t);
+	assert(empty.size() == t.size());
+	t.unite(tf::search_tree<int, int>());
+	assert(empty.size() == t.size());
+
+	// values of equal keys are kept with duplicate keys allowed
+	tf::search_tree<int, int> t4(true);
+	t4.insert(1, 1);
+	t4.insert(1, 2);
+	tf::search_tree<int, int> t5(true);
+	t5.insert(1, 3);
+	t5.insert(2, 4);
+	t4.unite(std::move(t5));
+	assert(t4.size() == 4);
+	assert(t4.count_range(1, 2) == 3);
+	assert(t4.contains_value(1, 3) == true);
+
+	try {
+		t.unite(t4);
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: insert, iteration
+void test_tree_intersect() {
+	tf::search_tree<int, int> t;
+	tf::search_tree<int, int> t2;
+	for (int i = 0; i < 50000; i += 2) {
+		t.insert(i, i);
+	}
+	for (int i = 0; i < 50000; i += 3) {
+		t2.insert(i, -i);
+	}
+
+	// -- //
+
+	t.intersect(t2, 4);
+	assert(t.size() == 8334);
+	assert(t2.size() == 16667);
+
+	int expected = 0;
+	for (auto it = t.begin(); it.has_value(); ++it) {
+		assert(it.key() == expected);
+		assert(*it == expected);
+		expected += 6;
+	}
+
+	t.intersect(t);
+	assert(t.size() == 8334);
+
+	t.intersect(tf::search_tree<int, int>());
+	assert(t.empty() == true);
+	assert(t.height() == 0);
+}
+
+// prec: insert, iteration
+void test_tree_subtract() {
+	tf::search_tree<int, int> t;
+	tf::search_tree<int, int> t2;
+	for (int i = 0; i < 50000; i += 2) {
+		t.insert(i, i);
+	}
+	for (int i = 0; i < 50000; i += 3) {
+		t2.insert(i, -i);
+	}
+
+	// -- //
+
+	t.subtract(t2, 4);
+	assert(t.size() == 25000 - 8334);
+	for (auto it = t.begin(); it.has_value(); ++it) {
+		assert(it.key() % 2 == 0);
+		assert(it.key() % 3 != 0);
+	}
+
+	t.subtract(tf::search_tree<int, int>());
+	assert(t.size() == 25000 - 8334);
+
+	t.subtract(t);
+	assert(t.empty() == true);
+
+	t.insert(1, 1);
+	assert(t.get(1) == 1);
+}
+
+// prec: insert, iteration, rank
+void test_tree_split_at() {
+	tf::search_tree<int, std::string> t;
+	for (int i = 0; i < 1000; ++i) {
+		t.insert(i, std::to_string(i));
+	}
+
+	// -- //
+
+	// small right part
+	tf::search_tree<int, std::string> right = t.split_at(900);
+	assert(t.size() == 900);
+	assert(right.size() == 100);
+	assert(t.max() == "899");
+	assert(right.min() == "900");
+	assert(right.rank(950) == 50);
+
+	// large right part
+	tf::search_tree<int, std::string> right2 = t.split_at(100);
+	assert(t.size() == 100);
+	assert(right2.size() == 800);
+	assert(t.max() == "99");
+	assert(right2.min() == "100");
+	assert(right2.max() == "899");
+
+	// key that does not exist
+	tf::search_tree<int, std::string> right3 = right2.split_at(-5);
+	assert(right2.size() == 0);
+	assert(right3.size() == 800);
+
+	tf::search_tree<int, std::string> right4 = right3.split_at(5000);
+	assert(right3.size() == 800);
+	assert(right4.empty() == true);
+
+	int expected = 100;
+	for (auto it = right3.begin(); it.has_value(); ++it) {
+		assert(it.key() == expected);
+		++expected;
+	}
+	assert(expected == 900);
+
+	right3.insert(5000, "5000");
+	right3.remove(500);
+	t.insert(-1, "nOne");
+	assert(right3.size() == 800);
+	assert(t.size() == 101);
+
+	tf::search_tree<std::string, int> t2(true);
+	t2.insert("a", 1);
+	t2.insert("b", 2);
+	t2.insert("b", 3);
+	tf::search_tree<std::string, int> right5 = t2.split_at(std::string_view("b"));
+	assert(t2.size() == 1);
+	assert(right5.size() == 2);
+	assert(right5.allows_duplicate_keys() == true);
+}
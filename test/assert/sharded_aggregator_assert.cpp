@@ -0,0 +1,169 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../tfds/tf_sharded_aggregator.hpp"
+
+void test_aggregator();
+void test_aggregator_constructor();
+void test_aggregator_add();
+void test_aggregator_merge();
+void test_aggregator_partitions();
+void test_aggregator_combine();
+void test_aggregator_threads();
+
+
+/* int main(int argc, char *argv[]) {
+	test_aggregator();
+
+	return 0;
+} */
+
+void test_aggregator() {
+	test_aggregator_constructor();
+	test_aggregator_add();
+	test_aggregator_merge();
+	test_aggregator_partitions();
+	test_aggregator_combine();
+	test_aggregator_threads();
+
+	std::cout << "SHARDED AGGREGATOR tests successful." << std::endl;
+}
+
+// prec: -
+void test_aggregator_constructor() {
+	tf::sharded_aggregator<std::string, int> a(4);
+	assert(a.num_workers() == 4);
+	assert(a.num_partitions() == 4);
+	assert(a.size() == 0);
+
+	tf::sharded_aggregator<std::string, int> a2(0, 16);
+	assert(a2.num_workers() == 1);
+	assert(a2.num_partitions() == 16);
+}
+
+// prec: constructor
+void test_aggregator_add() {
+	tf::sharded_aggregator<std::string, int> a(2);
+
+	// -- //
+
+	a.add(0, "One", 1);
+	a.add(0, "One", 1);
+	a.add(1, "One", 1);
+	a.add(1, std::string("Two"), 2);
+
+	try {
+		a.add(2, "One", 1);
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: add
+void test_aggregator_merge() {
+	tf::sharded_aggregator<std::string, int> a(3);
+	a.add(0, "One", 1);
+	a.add(0, "One", 1);
+	a.add(1, "One", 1);
+	a.add(1, "Two", 2);
+	a.add(2, "Three", 3);
+
+	// -- //
+
+	a.merge();
+	assert(a.size() == 3);
+	assert(a.get("One") == 3);
+	assert(a.get("Two") == 2);
+	assert(a.get("Three") == 3);
+	assert(a.contains("Four") == false);
+
+	try {
+		a.get("Four");
+		assert(false);
+	} catch (tf::exception &) {}
+
+	// adding after a merge continues the aggregation
+	a.add(2, "One", 10);
+	a.add(1, "Four", 4);
+	a.merge(1);
+	assert(a.size() == 4);
+	assert(a.get("One") == 13);
+	assert(a.get("Four") == 4);
+
+	a.clear();
+	assert(a.size() == 0);
+	assert(a.contains("One") == false);
+}
+
+// prec: merge
+void test_aggregator_partitions() {
+	tf::sharded_aggregator<int, int> a(2, 8);
+	for (int i = 0; i < 1000; ++i) {
+		a.add(i % 2, i % 100, 1);
+	}
+
+	// -- //
+
+	a.merge(4);
+
+	size_t entries = 0;
+	for (size_t p = 0; p < a.num_partitions(); ++p) {
+		for (auto it = a.partition(p).begin(); it.has_value(); ++it) {
+			assert(*it == 10);
+			++entries;
+		}
+	}
+	assert(entries == 100);
+	assert(a.size() == 100);
+
+	try {
+		a.partition(8);
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: merge
+void test_aggregator_combine() {
+	auto longest = [](std::string old_value, const std::string &value) { return (value.size() > old_value.size()) ? value : old_value; };
+	tf::sharded_aggregator<int, std::string, decltype(longest)> a(2, 0, longest);
+
+	// -- //
+
+	a.add(0, 1, std::string("a"));
+	a.add(1, 1, std::string("abc"));
+	a.add(0, 1, std::string("ab"));
+	a.merge();
+	assert(a.get(1) == "abc");
+}
+
+// prec: partitions
+void test_aggregator_threads() {
+	const int num_threads = 4;
+	const int num_keys = 1000;
+	const int repeats = 50;
+	tf::sharded_aggregator<int, long long> a(num_threads);
+
+	// -- //
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < num_threads; ++t) {
+		threads.emplace_back([&a, t]() {
+			for (int r = 0; r < repeats; ++r) {
+				for (int i = 0; i < num_keys; ++i) {
+					a.add(t, i, static_cast<long long>(i));
+				}
+			}
+		});
+	}
+
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+
+	a.merge(num_threads);
+	assert(a.size() == num_keys);
+	for (int i = 0; i < num_keys; ++i) {
+		assert(a.get(i) == static_cast<long long>(i) * repeats * num_threads);
+	}
+}
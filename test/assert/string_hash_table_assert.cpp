@@ -0,0 +1,328 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../../tfds/tf_string_hash_table.hpp"
+
+void test_string_table();
+void test_string_table_default_constructor();
+void test_string_table_insert();
+void test_string_table_get();
+void test_string_table_copy_constructor();
+void test_string_table_move_constructor();
+void test_string_table_brackets_operator();
+void test_string_table_remove();
+void test_string_table_iteration();
+void test_string_table_insert_own_key();
+void test_string_table_compact();
+void test_string_table_clear();
+void test_string_table_growth();
+
+
+/* int main(int argc, char *argv[]) {
+	test_string_table();
+
+	return 0;
+} */
+
+void test_string_table() {
+	test_string_table_default_constructor();
+	test_string_table_insert();
+	test_string_table_get();
+	test_string_table_copy_constructor();
+	test_string_table_move_constructor();
+	test_string_table_brackets_operator();
+	test_string_table_remove();
+	test_string_table_iteration();
+	test_string_table_insert_own_key();
+	test_string_table_compact();
+	test_string_table_clear();
+	test_string_table_growth();
+
+	std::cout << "STRING HASH TABLE tests successful." << std::endl;
+}
+
+// prec: -
+void test_string_table_default_constructor() {
+	tf::string_hash_table<int> h;
+	assert(h.size() == 0);
+	assert(h.table_size() == 100);
+	assert(h.arena_size() == 0);
+	assert(h.empty() == true);
+}
+
+// prec: default_constructor
+void test_string_table_insert() {
+	tf::string_hash_table<int> h;
+
+	// -- //
+
+	h.insert("One", 1);
+	assert(h.size() == 1);
+	assert(h.arena_size() == 3);
+
+	h.insert(std::string("Two"), 2);
+	h.insert(std::string_view("Three"), 3);
+	h.insert("", 0);
+	assert(h.size() == 4);
+	assert(h.arena_size() == 11);
+
+	try {
+		h.insert("Two", 22);
+		assert(false);
+	} catch (tf::exception &) {}
+	assert(h.size() == 4);
+	assert(h.arena_size() == 11);
+
+	tf::string_hash_table<std::vector<int>> h2;
+	assert(h2.emplace("Vector", 3, 7).size() == 3);
+	assert(h2.get("Vector")[2] == 7);
+}
+
+// prec: insert
+void test_string_table_get() {
+	tf::string_hash_table<int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+	h.insert("", 0);
+
+	// -- //
+
+	std::string buffer = "OneTwo";
+	assert(h.get(std::string_view(buffer.data(), 3)) == 1);
+	assert(h.get(std::string_view(buffer.data() + 3, 3)) == 2);
+	assert(h.get("") == 0);
+	assert(h.contains("On") == false);
+	assert(h.contains("One") == true);
+
+	try {
+		h.get("Three");
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: get
+void test_string_table_copy_constructor() {
+	tf::string_hash_table<int> h;
+	h.insert("One", 1);
+	h.insert("Two", 2);
+	h.remove("One");
+
+	// -- //
+
+	tf::string_hash_table<int> h2(h);
+	assert(h2.size() == 1);
+	assert(h2.get("Two") == 2);
+	assert(h2.arena_size() == 3);
+
+	h2.insert("Three", 3);
+	assert(h.contains("Three") == false);
+
+	tf::string_hash_table<int> h3;
+	h3 = h2;
+	assert(h3.get("Three") == 3);
+}
+
+// prec: get
+void test_string_table_move_constructor() {
+	tf::string_hash_table<int> h;
+	h.insert("One", 1);
+
+	// -- //
+
+	tf::string_hash_table<int> h2(std::move(h));
+	assert(h2.get("One") == 1);
+	assert(h.size() == 0);
+}
+
+// prec: get
+void test_string_table_brackets_operator() {
+	tf::string_hash_table<int> h;
+	h.insert("One", 1);
+
+	// -- //
+
+	h["One"] = 11;
+	assert(h["One"] == 11);
+
+	const tf::string_hash_table<int> &c = h;
+	assert(c["One"] == 11);
+
+	try {
+		h["Two"];
+		assert(false);
+	} catch (tf::exception &) {}
+}
+
+// prec: get
+void test_string_table_remove() {
+	tf::string_hash_table<std::string> h;
+	h.insert("One", "1");
+	h.insert("Two", "2");
+
+	// -- //
+
+	assert(h.remove("One") == "1");
+	assert(h.size() == 1);
+	assert(h.contains("One") == false);
+	assert(h.garbage_size() == 3);
+
+	try {
+		h.remove("One");
+		assert(false);
+	} catch (tf::exception &) {}
+
+	h.insert("One", "11");
+	assert(h.get("One") == "11");
+}
+
+// prec: insert
+void test_string_table_iteration() {
+	tf::string_hash_table<int> h;
+	h.insert("1", 1);
+	h.insert("22", 2);
+	h.insert("333", 3);
+
+	// -- //
+
+	int sum = 0;
+	for (auto it = h.begin(); it.has_value(); ++it) {
+		assert(static_cast<int>(it.key().size()) == *it);
+		sum += it.value();
+	}
+	assert(sum == 6);
+}
+
+// prec: iteration
+void test_string_table_insert_own_key() {
+	tf::string_hash_table<int> h;
+	h.insert("0123456789", 10);
+
+	// -- //
+
+	// the keys are views into the arena, which is reallocated while they are inserted
+	for (int length = 9; length > 0; --length) {
+		auto it = h.begin();
+		while (static_cast<int>(it.key().size()) != length + 1) {
+			++it;
+		}
+
+		h.insert(it.key().substr(0, length), length);
+	}
+	assert(h.size() == 10);
+	assert(h.arena_size() == 55);
+
+	for (int length = 1; length <= 10; ++length) {
+		assert(h.get(std::string("0123456789", length)) == length);
+	}
+}
+
+// prec: remove
+void test_string_table_compact() {
+	tf::string_hash_table<int> h;
+	for (int i = 0; i < 100; ++i) {
+		h.insert(std::to_string(i), i);
+	}
+
+	// -- //
+
+	size_t arena_size = h.arena_size();
+	for (int i = 0; i < 100; i += 2) {
+		h.remove(std::to_string(i));
+	}
+	assert(h.arena_size() == arena_size);
+
+	h.compact();
+	assert(h.garbage_size() == 0);
+	assert(h.arena_size() < arena_size);
+	for (int i = 0; i < 100; ++i) {
+		assert(h.contains(std::to_string(i)) == (i % 2 == 1));
+		if (i % 2 == 1)
+			assert(h.get(std::to_string(i)) == i);
+	}
+}
+
+// prec: insert
+void test_string_table_clear() {
+	tf::string_hash_table<std::string> h;
+	h.insert("One", "1");
+	h.insert("Two", "2");
+
+	// -- //
+
+	h.clear();
+	assert(h.size() == 0);
+	assert(h.arena_size() == 0);
+	assert(h.contains("One") == false);
+
+	h.insert("One", "1");
+	assert(h.get("One") == "1");
+}
+
+// prec: get
+void test_string_table_growth() {
+	tf::string_hash_table<int> h(1);
+
+	// -- //
+
+	for (int i = 0; i < 10000; ++i) {
+		h.insert("key" + std::to_string(i), i);
+	}
+	assert(h.size() == 10000);
+	assert(h.load_factor() <= 1.0f);
+
+	for (int i = 0; i < 10000; ++i) {
+		assert(h.get("key" + std::to_string(i)) == i);
+	}
+
+	h.reserve(50000, 1000000);
+	assert(h.table_size() == 50000);
+	assert(h.rehashing() == false);
+	h.rehash(10);
+	assert(h.table_size() == 10000);
+	assert(h.get("key9999") == 9999);
+
+	// -- //
+
+	// the chains are migrated a few at a time, entries in both tables stay reachable
+	tf::string_hash_table<int> h2(16);
+	h2.set_max_load_factor(2.0f);
+	assert(h2.max_load_factor() == 2.0f);
+
+	bool migrated_incrementally = false;
+	for (int i = 0; i < 10000; ++i) {
+		h2.insert("key" + std::to_string(i), i);
+		assert(h2.load_factor() <= 2.0f);
+		if (h2.rehashing()) {
+			migrated_incrementally = true;
+			assert(h2.get("key0") == 0);
+			assert(h2.get("key" + std::to_string(i)) == i);
+		}
+	}
+	assert(migrated_incrementally);
+
+	int sum = 0;
+	int count = 0;
+	for (auto it = h2.begin(); it.has_value(); ++it) {
+		sum += *it;
+		++count;
+	}
+	assert(count == 10000);
+	assert(sum == 9999 * 10000 / 2);
+
+	tf::string_hash_table<int> h3(h2);
+	for (int i = 0; i < 10000; i += 2) {
+		assert(h2.remove("key" + std::to_string(i)) == i);
+	}
+	h2.compact();
+	for (int i = 0; i < 10000; ++i) {
+		assert(h2.contains("key" + std::to_string(i)) == (i % 2 == 1));
+		assert(h3.get("key" + std::to_string(i)) == i);
+	}
+
+	try {
+		h2.set_max_load_factor(0.0f);
+		assert(false);
+	} catch (tf::exception &) {}
+}
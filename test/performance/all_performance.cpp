@@ -1,7 +1,11 @@
 #include "vector_performance.cpp"
 #include "linked_list_performance.cpp"
 #include "hash_table_performance.cpp"
+#include "concurrent_hash_table_performance.cpp"
+#include "sharded_aggregator_performance.cpp"
 #include "search_tree_performance.cpp"
+#include "bplus_tree_performance.cpp"
+#include "concurrent_bplus_tree_performance.cpp"
 
 // Naive tfds performance measure (mostly inserting and accessing of std::strings)
 int main(int argc, char *argv[]) {
@@ -15,9 +19,31 @@ int main(int argc, char *argv[]) {
 	std::cout << "******************************" << std::endl << std::endl;
 
 	print_table_performance(num_elements, runs);
+	print_long_key_table_performance(num_elements, runs);
+	print_batch_lookup_performance(num_elements, runs);
+	print_snapshot_performance(num_elements, runs);
+	print_string_table_performance(num_elements, runs);
+	print_bulk_build_performance(num_elements, runs);
+	print_iteration_performance(num_elements, runs);
+	print_bloom_filter_performance(num_elements, runs);
+	print_insert_latency_performance(num_elements, runs);
+	std::cout << "******************************" << std::endl << std::endl;
+
+	print_hash_performance(num_elements, runs);
+	std::cout << "******************************" << std::endl << std::endl;
+
+	print_concurrent_table_performance(num_elements, runs);
+	print_aggregator_performance(num_elements, runs);
 	std::cout << "******************************" << std::endl << std::endl;
 
 	print_tree_performance(num_elements, runs);
+	print_tree_range_performance(num_elements, runs);
+	print_tree_percentile_performance(num_elements, runs);
+	print_tree_bulk_build_performance(num_elements, runs);
+	print_tree_set_operation_performance(num_elements, runs);
+	print_bplus_tree_performance(num_elements, runs);
+	print_bplus_tree_range_performance(num_elements, runs);
+	print_concurrent_bplus_tree_performance(num_elements, runs);
 
 	return 0;
 }
@@ -0,0 +1,279 @@
+#include <iostream>
+#include <string>
+#include <map>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include "../../tfds/tf_search_tree.hpp"
+#include "../../tfds/tf_bplus_tree.hpp"
+
+void print_bplus_tree_performance(int num_elements, int runs) {
+	long long std_insert_ms = 0;
+	long long tree_insert_ms = 0;
+	long long bplus_insert_ms = 0;
+
+	long long std_get_ms = 0;
+	long long tree_get_ms = 0;
+	long long bplus_get_ms = 0;
+
+	long long std_iterate_ms = 0;
+	long long tree_iterate_ms = 0;
+	long long bplus_iterate_ms = 0;
+
+	long long std_remove_ms = 0;
+	long long tree_remove_ms = 0;
+	long long bplus_remove_ms = 0;
+
+	// the keys are inserted and accessed in random order
+	std::vector<int> keys(num_elements);
+	for (int i = 0; i < num_elements; ++i) {
+		keys[i] = i;
+	}
+	std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+	unsigned long long sum = 0;
+
+	for (int run = 0; run < runs; ++run) {
+		std::map<int, int> std_map;
+		tf::search_tree<int, int> tf_tree;
+		tf::bplus_tree<int, int> tf_bplus_tree;
+
+		// INSERT
+
+		// std
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (int key : keys) {
+			std_map[key] = key;
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		std_insert_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf search tree
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int key : keys) {
+			tf_tree.insert(key, key);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tree_insert_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf b+ tree
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int key : keys) {
+			tf_bplus_tree.insert(key, key);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		bplus_insert_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// GET
+
+		// std
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int key : keys) {
+			sum += std_map.at(key);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		std_get_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf search tree
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int key : keys) {
+			sum += tf_tree.get(key);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tree_get_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf b+ tree
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int key : keys) {
+			sum += tf_bplus_tree.get(key);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		bplus_get_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// ITERATE
+
+		// std
+		start = std::chrono::high_resolution_clock::now();
+
+		for (auto &entry : std_map) {
+			sum += entry.second;
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		std_iterate_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf search tree
+		start = std::chrono::high_resolution_clock::now();
+
+		for (auto it = tf_tree.begin(); it.has_value(); ++it) {
+			sum += *it;
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tree_iterate_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf b+ tree
+		start = std::chrono::high_resolution_clock::now();
+
+		for (auto it = tf_bplus_tree.begin(); it.has_value(); ++it) {
+			sum += *it;
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		bplus_iterate_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// REMOVE
+
+		// std
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int key : keys) {
+			std_map.erase(key);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		std_remove_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf search tree
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int key : keys) {
+			tf_tree.remove(key);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tree_remove_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf b+ tree
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int key : keys) {
+			tf_bplus_tree.remove(key);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		bplus_remove_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+	}
+
+	std_insert_ms /= runs;
+	tree_insert_ms /= runs;
+	bplus_insert_ms /= runs;
+
+	std_get_ms /= runs;
+	tree_get_ms /= runs;
+	bplus_get_ms /= runs;
+
+	std_iterate_ms /= runs;
+	tree_iterate_ms /= runs;
+	bplus_iterate_ms /= runs;
+
+	std_remove_ms /= runs;
+	tree_remove_ms /= runs;
+	bplus_remove_ms /= runs;
+
+	std::cout << "| B+ TREE | (checksum " << sum % 10 << ")" << std::endl << std::endl;
+
+	std::cout << "Inserting " << num_elements << " (int, int) pairs in random order:" << std::endl;
+	std::cout << "std::map: " << std_insert_ms << " milliseconds" << std::endl;
+	std::cout << "tf::search_tree: " << tree_insert_ms << " milliseconds" << std::endl;
+	std::cout << "tf::bplus_tree: " << bplus_insert_ms << " milliseconds" << std::endl << std::endl;
+
+	std::cout << "Accessing " << num_elements << " (int, int) pairs in random order:" << std::endl;
+	std::cout << "std::map: " << std_get_ms << " milliseconds" << std::endl;
+	std::cout << "tf::search_tree: " << tree_get_ms << " milliseconds" << std::endl;
+	std::cout << "tf::bplus_tree: " << bplus_get_ms << " milliseconds" << std::endl << std::endl;
+
+	std::cout << "Iterating over " << num_elements << " (int, int) pairs:" << std::endl;
+	std::cout << "std::map: " << std_iterate_ms << " milliseconds" << std::endl;
+	std::cout << "tf::search_tree: " << tree_iterate_ms << " milliseconds" << std::endl;
+	std::cout << "tf::bplus_tree: " << bplus_iterate_ms << " milliseconds" << std::endl << std::endl;
+
+	std::cout << "Removing " << num_elements << " (int, int) pairs in random order:" << std::endl;
+	std::cout << "std::map: " << std_remove_ms << " milliseconds" << std::endl;
+	std::cout << "tf::search_tree: " << tree_remove_ms << " milliseconds" << std::endl;
+	std::cout << "tf::bplus_tree: " << bplus_remove_ms << " milliseconds" << std::endl << std::endl;
+}
+
+void print_bplus_tree_range_performance(int num_elements, int runs) {
+	long long std_range_ms = 0;
+	long long tree_range_ms = 0;
+	long long bplus_range_ms = 0;
+
+	const int num_queries = 1000;
+	const int range_width = 100;
+
+	std::map<int, int> std_map;
+	tf::search_tree<int, int> tf_tree;
+	tf::bplus_tree<int, int> tf_bplus_tree;
+	for (int i = 0; i < num_elements; ++i) {
+		std_map[i] = i;
+		tf_tree.insert(i, i);
+		tf_bplus_tree.insert(i, i);
+	}
+
+	unsigned long long sum = 0;
+
+	// every query starts at a key and reads the following range_width entries
+	auto time_queries = [&sum, num_elements](auto query) {
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (int q = 0; q < num_queries; ++q) {
+			sum += query(static_cast<int>((q * 2654435761U) % num_elements));
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+	};
+
+	for (int run = 0; run < runs; ++run) {
+		std_range_ms += time_queries([&std_map](int first) {
+			unsigned long long query_sum = 0;
+			auto last = std_map.lower_bound(first + range_width);
+			for (auto it = std_map.lower_bound(first); it != last; ++it) {
+				query_sum += it->second;
+			}
+
+			return query_sum;
+		});
+
+		tree_range_ms += time_queries([&tf_tree](int first) {
+			unsigned long long query_sum = 0;
+			for (auto it = tf_tree.range(first, first + range_width); it.has_value(); ++it) {
+				query_sum += *it;
+			}
+
+			return query_sum;
+		});
+
+		bplus_range_ms += time_queries([&tf_bplus_tree](int first) {
+			unsigned long long query_sum = 0;
+			for (auto it = tf_bplus_tree.range(first, first + range_width); it.has_value(); ++it) {
+				query_sum += *it;
+			}
+
+			return query_sum;
+		});
+	}
+
+	std_range_ms /= runs;
+	tree_range_ms /= runs;
+	bplus_range_ms /= runs;
+
+	std::cout << num_queries << " range queries over " << range_width << " of " << num_elements << " keys (checksum " << sum % 10 << "):" << std::endl;
+	std::cout << "std::map (lower_bound): " << std_range_ms << " milliseconds" << std::endl;
+	std::cout << "tf::search_tree (range): " << tree_range_ms << " milliseconds" << std::endl;
+	std::cout << "tf::bplus_tree (range): " << bplus_range_ms << " milliseconds" << std::endl << std::endl;
+}
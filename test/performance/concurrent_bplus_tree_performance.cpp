@@ -0,0 +1,139 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+#include <chrono>
+#include "../../tfds/tf_bplus_tree.hpp"
+#include "../../tfds/tf_concurrent_bplus_tree.hpp"
+
+// the threads share num_elements operations on a tree with num_elements entries, write_percent of them are
+// writes (alternately inserting a new key and removing it again), the others look up existing keys.
+// run_threads(...) is defined in concurrent_hash_table_performance.cpp
+void print_concurrent_bplus_tree_mix_performance(int num_elements, int runs, int write_percent) {
+	int max_threads = std::thread::hardware_concurrency();
+	if (max_threads < 4)
+		max_threads = 4;
+
+	std::cout << "Accessing " << num_elements << " (int, int) pairs (" << 100 - write_percent << "% lookups, " << write_percent << "% writes):" << std::endl;
+
+	unsigned long long sum = 0;
+
+	for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+		long long locked_ms = 0;
+		long long shared_locked_ms = 0;
+		long long tf_ms = 0;
+
+		int operations_per_thread = num_elements / num_threads;
+
+		// the entries have even keys, the writers use odd keys that are unique per thread
+		auto read_key = [num_elements](int t, int i) {
+			return static_cast<int>((i * 7919LL + t) % num_elements) * 2;
+		};
+		auto write_key = [operations_per_thread](int t, int i) {
+			return (t * operations_per_thread + i) * 2 + 1;
+		};
+
+		for (int run = 0; run < runs; ++run) {
+			// a tf::bplus_tree behind one mutex and behind one reader-writer lock
+			std::mutex mutex;
+			std::shared_mutex shared_mutex;
+			tf::bplus_tree<int, int> locked_tree;
+			tf::bplus_tree<int, int> shared_locked_tree;
+			tf::concurrent_bplus_tree<int, int> tf_tree;
+
+			for (int i = 0; i < num_elements; ++i) {
+				locked_tree.insert(i * 2, i);
+				shared_locked_tree.insert(i * 2, i);
+				tf_tree.insert(i * 2, i);
+			}
+
+			std::vector<unsigned long long> sums(max_threads, 0);
+
+			locked_ms += run_threads(num_threads, [&](int t) {
+				unsigned long long thread_sum = 0;
+				bool inserted = false;
+				int inserted_key = 0;
+				for (int i = 0; i < operations_per_thread; ++i) {
+					std::lock_guard<std::mutex> lock(mutex);
+					if (i % 100 < write_percent) {
+						if (inserted)
+							locked_tree.remove(inserted_key);
+						else
+							locked_tree.insert(inserted_key = write_key(t, i), i);
+						inserted = !inserted;
+					}
+					else {
+						thread_sum += locked_tree.get(read_key(t, i));
+					}
+				}
+
+				sums[t] = thread_sum;
+			});
+
+			shared_locked_ms += run_threads(num_threads, [&](int t) {
+				unsigned long long thread_sum = 0;
+				bool inserted = false;
+				int inserted_key = 0;
+				for (int i = 0; i < operations_per_thread; ++i) {
+					if (i % 100 < write_percent) {
+						std::unique_lock<std::shared_mutex> lock(shared_mutex);
+						if (inserted)
+							shared_locked_tree.remove(inserted_key);
+						else
+							shared_locked_tree.insert(inserted_key = write_key(t, i), i);
+						inserted = !inserted;
+					}
+					else {
+						std::shared_lock<std::shared_mutex> lock(shared_mutex);
+						thread_sum += shared_locked_tree.get(read_key(t, i));
+					}
+				}
+
+				sums[t] = thread_sum;
+			});
+
+			tf_ms += run_threads(num_threads, [&](int t) {
+				unsigned long long thread_sum = 0;
+				bool inserted = false;
+				int inserted_key = 0;
+				for (int i = 0; i < operations_per_thread; ++i) {
+					if (i % 100 < write_percent) {
+						if (inserted)
+							tf_tree.remove(inserted_key);
+						else
+							tf_tree.insert(inserted_key = write_key(t, i), i);
+						inserted = !inserted;
+					}
+					else {
+						thread_sum += tf_tree.get(read_key(t, i));
+					}
+				}
+
+				sums[t] = thread_sum;
+			});
+
+			for (unsigned long long thread_sum : sums) {
+				sum += thread_sum;
+			}
+		}
+
+		locked_ms /= runs;
+		shared_locked_ms /= runs;
+		tf_ms /= runs;
+
+		std::cout << num_threads << " thread(s) (checksum " << sum % 10 << "):" << std::endl;
+		std::cout << "tf::bplus_tree with std::mutex: " << locked_ms << " milliseconds" << std::endl;
+		std::cout << "tf::bplus_tree with std::shared_mutex: " << shared_locked_ms << " milliseconds" << std::endl;
+		std::cout << "tf::concurrent_bplus_tree: " << tf_ms << " milliseconds" << std::endl;
+	}
+
+	std::cout << std::endl;
+}
+
+void print_concurrent_bplus_tree_performance(int num_elements, int runs) {
+	std::cout << "| CONCURRENT B+ TREE |" << std::endl << std::endl;
+
+	print_concurrent_bplus_tree_mix_performance(num_elements, runs, 5);
+	print_concurrent_bplus_tree_mix_performance(num_elements, runs, 50);
+}
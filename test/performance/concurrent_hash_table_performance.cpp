@@ -0,0 +1,103 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include "../../tfds/tf_hash_table.hpp"
+#include "../../tfds/tf_concurrent_hash_table.hpp"
+
+// runs operations(thread index) on num_threads threads and returns the elapsed time
+template <typename F>
+long long run_threads(int num_threads, F operations) {
+	std::vector<std::thread> threads;
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (int t = 0; t < num_threads; ++t) {
+		threads.emplace_back(operations, t);
+	}
+
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+
+	auto elapsed = std::chrono::high_resolution_clock::now() - start;
+	return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+}
+
+// the threads share num_elements operations, every write_interval-th operation is an insert/remove pair instead of a lookup
+void print_concurrent_table_performance(int num_elements, int runs) {
+	const int write_interval = 10;
+	int max_threads = std::thread::hardware_concurrency();
+	if (max_threads < 4)
+		max_threads = 4;
+
+	std::cout << "| CONCURRENT HASH TABLE |" << std::endl << std::endl;
+
+	std::cout << "Accessing " << num_elements << " (int, int) pairs (one insert and one remove per " << write_interval << " lookups):" << std::endl;
+
+	for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+		long long locked_ms = 0;
+		long long tf_ms = 0;
+
+		int operations_per_thread = num_elements / num_threads;
+
+		for (int run = 0; run < runs; ++run) {
+			// a tf::hash_table behind one mutex
+			std::mutex mutex;
+			// large enough that the inserts do not start a resize
+			tf::hash_table<int, int> locked_table(2 * num_elements);
+			tf::concurrent_hash_table<int, int> tf_table(2 * num_elements);
+
+			for (int i = 0; i < num_elements; ++i) {
+				locked_table.insert(i, i);
+				tf_table.insert(i, i);
+			}
+
+			locked_ms += run_threads(num_threads, [&](int t) {
+				long long sum = 0;
+				for (int i = 0; i < operations_per_thread; ++i) {
+					std::lock_guard<std::mutex> lock(mutex);
+					if (i % write_interval == 0) {
+						int key = num_elements + t * operations_per_thread + i;
+						locked_table.insert(key, i);
+						locked_table.remove(key);
+					}
+					else {
+						sum += locked_table.get(static_cast<int>((i * 7919LL + t) % num_elements));
+					}
+				}
+
+				if (sum == -1)
+					std::cout << sum;
+			});
+
+			tf_ms += run_threads(num_threads, [&](int t) {
+				long long sum = 0;
+				for (int i = 0; i < operations_per_thread; ++i) {
+					if (i % write_interval == 0) {
+						int key = num_elements + t * operations_per_thread + i;
+						tf_table.insert(key, i);
+						tf_table.remove(key);
+					}
+					else {
+						sum += tf_table.get(static_cast<int>((i * 7919LL + t) % num_elements));
+					}
+				}
+
+				if (sum == -1)
+					std::cout << sum;
+			});
+		}
+
+		locked_ms /= runs;
+		tf_ms /= runs;
+
+		std::cout << num_threads << " thread(s):" << std::endl;
+		std::cout << "tf::hash_table with std::mutex: " << locked_ms << " milliseconds" << std::endl;
+		std::cout << "tf::concurrent_hash_table: " << tf_ms << " milliseconds" << std::endl;
+	}
+
+	std::cout << std::endl;
+}
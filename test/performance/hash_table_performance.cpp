@@ -1,20 +1,31 @@
 #include <iostream>
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <functional>
 #include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <random>
 #include "../../tfds/tf_hash_table.hpp"
+#include "../../tfds/tf_flat_hash_table.hpp"
+#include "../../tfds/tf_hash_table_view.hpp"
+#include "../../tfds/tf_string_hash_table.hpp"
 
 void print_table_performance(int num_elements, int runs) {
 	long long std_insert_ms = 0;
 	long long tf_insert_ms = 0;
+	long long tf_flat_insert_ms = 0;
 
 	long long std_get_ms = 0;
 	long long tf_get_ms = 0;
+	long long tf_flat_get_ms = 0;
 
 	for (int run = 0; run < runs; ++run) {
 		std::unordered_map<std::string, int> std_map;
 		std_map.reserve(num_elements);
 		tf::hash_table<std::string, int> tf_table(num_elements);
+		tf::flat_hash_table<std::string, int> tf_flat_table(num_elements);
 
 		// INSERT
 
@@ -38,6 +49,16 @@ void print_table_performance(int num_elements, int runs) {
 		elapsed = std::chrono::high_resolution_clock::now() - start;
 		tf_insert_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
 
+		// tf flat
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			tf_flat_table.insert(std::to_string(i), i);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_flat_insert_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
 		// GET
 
 		//std
@@ -50,8 +71,6 @@ void print_table_performance(int num_elements, int runs) {
 		elapsed = std::chrono::high_resolution_clock::now() - start;
 		std_get_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
 
-		// INSERT
-
 		// tf
 		start = std::chrono::high_resolution_clock::now();
 
@@ -61,21 +80,671 @@ void print_table_performance(int num_elements, int runs) {
 
 		elapsed = std::chrono::high_resolution_clock::now() - start;
 		tf_get_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf flat
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			tf_flat_table.get(std::to_string(i));
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_flat_get_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
 	}
 
 	std_insert_ms /= runs;
 	tf_insert_ms /= runs;
+	tf_flat_insert_ms /= runs;
 
 	std_get_ms /= runs;
 	tf_get_ms /= runs;
+	tf_flat_get_ms /= runs;
 
 	std::cout << "| HASH TABLE |" << std::endl << std::endl;
 
 	std::cout << "Inserting " << num_elements << " (std::string, int) pairs:" << std::endl;
 	std::cout << "std::unordered_map: " << std_insert_ms << " milliseconds" << std::endl;
-	std::cout << "tf::hash_table: " << tf_insert_ms << " milliseconds" << std::endl << std::endl;
+	std::cout << "tf::hash_table: " << tf_insert_ms << " milliseconds" << std::endl;
+	std::cout << "tf::flat_hash_table: " << tf_flat_insert_ms << " milliseconds" << std::endl << std::endl;
 
 	std::cout << "Accessing " << num_elements << " (std::string, int) pairs:" << std::endl;
 	std::cout << "std::unordered_map: " << std_get_ms << " milliseconds" << std::endl;
+	std::cout << "tf::hash_table: " << tf_get_ms << " milliseconds" << std::endl;
+	std::cout << "tf::flat_hash_table: " << tf_flat_get_ms << " milliseconds" << std::endl << std::endl;
+}
+
+void print_long_key_table_performance(int num_elements, int runs) {
+	// keys with a long common prefix are expensive to compare, 8 entries per bucket force collisions
+	const std::string prefix = "https://www.example.com/a/rather/long/path/that/every/key/shares/before/the/differing/part/";
+	const float load_factor = 8.0f;
+
+	std::vector<std::string> keys;
+	for (int i = 0; i < num_elements; ++i) {
+		keys.push_back(prefix + std::to_string(i));
+	}
+
+	long long std_get_ms = 0;
+	long long tf_get_ms = 0;
+
+	for (int run = 0; run < runs; ++run) {
+		std::unordered_map<std::string, int> std_map;
+		std_map.max_load_factor(load_factor);
+		std_map.rehash(num_elements / load_factor);
+		tf::hash_table<std::string, int> tf_table(num_elements / load_factor);
+		tf_table.set_max_load_factor(load_factor);
+
+		for (int i = 0; i < num_elements; ++i) {
+			std_map[keys[i]] = i;
+			tf_table.insert(keys[i], i);
+		}
+
+		// GET
+
+		// std
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			std_map.at(keys[i]);
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		std_get_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			tf_table.get(keys[i]);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_get_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+	}
+
+	std_get_ms /= runs;
+	tf_get_ms /= runs;
+
+	std::cout << "Accessing " << num_elements << " (std::string, int) pairs with " << keys[0].size() << "+ character keys and " << load_factor << " entries per bucket:" << std::endl;
+	std::cout << "std::unordered_map: " << std_get_ms << " milliseconds" << std::endl;
 	std::cout << "tf::hash_table: " << tf_get_ms << " milliseconds" << std::endl << std::endl;
 }
+
+void print_hash_performance(int num_elements, int runs) {
+	const int num_keys = 1000;
+	const size_t key_lengths[] = { 8, 64, 1024 };
+
+	std::cout << "| HASH FUNCTION |" << std::endl << std::endl;
+
+	for (size_t key_length : key_lengths) {
+		std::vector<std::string> keys;
+		for (int i = 0; i < num_keys; ++i) {
+			std::string key = std::to_string(i);
+			keys.push_back(key + std::string(key_length - key.size(), 'x'));
+		}
+
+		long long std_hash_ms = 0;
+		long long tf_hash_ms = 0;
+
+		// prevents the hashing from being optimized away
+		unsigned long long sum = 0;
+
+		for (int run = 0; run < runs; ++run) {
+			// std
+			std::hash<std::string> std_hash;
+			auto start = std::chrono::high_resolution_clock::now();
+
+			for (int i = 0; i < num_elements; ++i) {
+				sum += std_hash(keys[i % num_keys]);
+			}
+
+			auto elapsed = std::chrono::high_resolution_clock::now() - start;
+			std_hash_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+			// tf
+			tf::hasher<std::string> tf_hash;
+			start = std::chrono::high_resolution_clock::now();
+
+			for (int i = 0; i < num_elements; ++i) {
+				sum += tf_hash(keys[i % num_keys]);
+			}
+
+			elapsed = std::chrono::high_resolution_clock::now() - start;
+			tf_hash_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+		}
+
+		std_hash_ms /= runs;
+		tf_hash_ms /= runs;
+
+		std::cout << "Hashing " << num_elements << " std::strings of length " << key_length << " (checksum " << sum % 10 << "):" << std::endl;
+		std::cout << "std::hash: " << std_hash_ms << " milliseconds" << std::endl;
+		std::cout << "tf::hasher: " << tf_hash_ms << " milliseconds" << std::endl << std::endl;
+	}
+
+	// integer keys are mixed with one multiplication (std::hash<int> usually returns the key itself),
+	// the table keys are scattered (a bijection of i), as sequential keys favour identity hashing
+	long long std_int_ms = 0;
+	long long tf_int_ms = 0;
+	long long std_int_table_ms = 0;
+	long long tf_int_table_ms = 0;
+	unsigned long long sum = 0;
+
+	for (int run = 0; run < runs; ++run) {
+		// hash
+		std::hash<int> std_hash;
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			sum += std_hash(i);
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		std_int_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		tf::hasher<int> tf_hash;
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			sum += tf_hash(i);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_int_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// table (insert and get)
+		std::unordered_map<int, int> std_map;
+		std_map.reserve(num_elements);
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			std_map[static_cast<int>(i * 2654435761U)] = i;
+		}
+		for (int i = 0; i < num_elements; ++i) {
+			sum += std_map[static_cast<int>(i * 2654435761U)];
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		std_int_table_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		tf::hash_table<int, int> tf_table(num_elements);
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			tf_table.insert(static_cast<int>(i * 2654435761U), i);
+		}
+		for (int i = 0; i < num_elements; ++i) {
+			sum += tf_table.get(static_cast<int>(i * 2654435761U));
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_int_table_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+	}
+
+	std_int_ms /= runs;
+	tf_int_ms /= runs;
+	std_int_table_ms /= runs;
+	tf_int_table_ms /= runs;
+
+	std::cout << "Hashing " << num_elements << " ints (checksum " << sum % 10 << "):" << std::endl;
+	std::cout << "std::hash: " << std_int_ms << " milliseconds" << std::endl;
+	std::cout << "tf::hasher: " << tf_int_ms << " milliseconds" << std::endl << std::endl;
+
+	std::cout << "Inserting and accessing " << num_elements << " (int, int) pairs:" << std::endl;
+	std::cout << "std::unordered_map: " << std_int_table_ms << " milliseconds" << std::endl;
+	std::cout << "tf::hash_table: " << tf_int_table_ms << " milliseconds" << std::endl << std::endl;
+}
+
+// the table holds table_factor * num_elements entries, so that it is much larger than the last level cache
+void print_batch_lookup_performance(int num_elements, int runs) {
+	const int table_factor = 8;
+	const int batch = 64;
+	const int num_entries = table_factor * num_elements;
+
+	std::cout << "| HASH TABLE BATCH LOOKUP |" << std::endl << std::endl;
+
+	tf::hash_table<int, int> tf_table(num_entries);
+	for (int i = 0; i < num_entries; ++i) {
+		tf_table.insert(i, i);
+	}
+
+	// random order, so that almost every lookup misses the cache
+	std::vector<int> keys(num_elements);
+	for (int i = 0; i < num_elements; ++i) {
+		keys[i] = static_cast<int>((i * 2654435761ULL) % num_entries);
+	}
+
+	long long single_ms = 0;
+	long long batch_ms = 0;
+
+	// prevents the lookups from being optimized away
+	long long sum = 0;
+
+	for (int run = 0; run < runs; ++run) {
+		// single
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			sum += tf_table.get(keys[i]);
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		single_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// batch
+		const int *values[batch];
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; i += batch) {
+			int n = (num_elements - i < batch) ? num_elements - i : batch;
+			tf_table.get_many(&keys[i], n, values);
+
+			for (int j = 0; j < n; ++j) {
+				sum += *values[j];
+			}
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		batch_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+	}
+
+	single_ms /= runs;
+	batch_ms /= runs;
+
+	std::cout << "Accessing " << num_elements << " random keys of " << num_entries << " (int, int) pairs (checksum " << sum % 10 << "):" << std::endl;
+	std::cout << "tf::hash_table get: " << single_ms << " milliseconds" << std::endl;
+	std::cout << "tf::hash_table get_many (" << batch << " keys): " << batch_ms << " milliseconds" << std::endl << std::endl;
+}
+
+// time until num_elements entries can be looked up: inserting them into a table vs opening a snapshot
+void print_snapshot_performance(int num_elements, int runs) {
+	const char *path = "hash_table_performance.snapshot";
+
+	std::cout << "| HASH TABLE SNAPSHOT |" << std::endl << std::endl;
+
+	std::vector<std::string> keys;
+	for (int i = 0; i < num_elements; ++i) {
+		keys.push_back(std::to_string(i));
+	}
+
+	{
+		tf::hash_table<std::string, int> tf_table(num_elements);
+		for (int i = 0; i < num_elements; ++i) {
+			tf_table.insert(keys[i], i);
+		}
+
+		tf::write_snapshot(tf_table, path);
+	}
+
+	long long insert_ms = 0;
+	long long open_ms = 0;
+	long long table_get_ms = 0;
+	long long view_get_ms = 0;
+
+	// prevents the lookups from being optimized away
+	long long sum = 0;
+
+	for (int run = 0; run < runs; ++run) {
+		// insert
+		auto start = std::chrono::high_resolution_clock::now();
+
+		tf::hash_table<std::string, int> tf_table(num_elements);
+		for (int i = 0; i < num_elements; ++i) {
+			tf_table.insert(keys[i], i);
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		insert_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// open
+		start = std::chrono::high_resolution_clock::now();
+
+		tf::hash_table_view<std::string, int> tf_view(path);
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		open_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// get
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			sum += tf_table.get(keys[i]);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		table_get_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			sum += tf_view.get(keys[i]);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		view_get_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+	}
+
+	std::remove(path);
+
+	insert_ms /= runs;
+	open_ms /= runs;
+	table_get_ms /= runs;
+	view_get_ms /= runs;
+
+	std::cout << "Loading " << num_elements << " (std::string, int) pairs (checksum " << sum % 10 << "):" << std::endl;
+	std::cout << "tf::hash_table insert: " << insert_ms << " milliseconds" << std::endl;
+	std::cout << "tf::hash_table_view open: " << open_ms << " milliseconds" << std::endl << std::endl;
+
+	std::cout << "Accessing " << num_elements << " (std::string, int) pairs:" << std::endl;
+	std::cout << "tf::hash_table: " << table_get_ms << " milliseconds" << std::endl;
+	std::cout << "tf::hash_table_view: " << view_get_ms << " milliseconds" << std::endl << std::endl;
+}
+
+// URL-like keys that are too long for the small string optimization
+void print_string_table_performance(int num_elements, int runs) {
+	std::cout << "| STRING HASH TABLE |" << std::endl << std::endl;
+
+	std::vector<std::string> keys;
+	for (int i = 0; i < num_elements; ++i) {
+		keys.push_back("https://www.example.com/path/to/page/" + std::to_string(i) + "?query=value");
+	}
+
+	long long tf_insert_ms = 0;
+	long long tf_string_insert_ms = 0;
+	long long tf_get_ms = 0;
+	long long tf_string_get_ms = 0;
+
+	// prevents the lookups from being optimized away
+	long long sum = 0;
+
+	for (int run = 0; run < runs; ++run) {
+		tf::hash_table<std::string, int> tf_table(num_elements);
+		tf::string_hash_table<int> tf_string_table(num_elements);
+
+		// INSERT
+
+		// tf
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			tf_table.insert(keys[i], i);
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_insert_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf string
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			tf_string_table.insert(keys[i], i);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_string_insert_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// GET
+
+		// tf
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			sum += tf_table.get(keys[i]);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_get_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf string
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			sum += tf_string_table.get(keys[i]);
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_string_get_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+	}
+
+	tf_insert_ms /= runs;
+	tf_string_insert_ms /= runs;
+	tf_get_ms /= runs;
+	tf_string_get_ms /= runs;
+
+	std::cout << "Inserting " << num_elements << " (std::string, int) pairs with " << keys[0].size() << "+ character keys:" << std::endl;
+	std::cout << "tf::hash_table: " << tf_insert_ms << " milliseconds" << std::endl;
+	std::cout << "tf::string_hash_table: " << tf_string_insert_ms << " milliseconds" << std::endl << std::endl;
+
+	std::cout << "Accessing " << num_elements << " (std::string, int) pairs with " << keys[0].size() << "+ character keys (checksum " << sum % 10 << "):" << std::endl;
+	std::cout << "tf::hash_table: " << tf_get_ms << " milliseconds" << std::endl;
+	std::cout << "tf::string_hash_table: " << tf_string_get_ms << " milliseconds" << std::endl << std::endl;
+}
+
+// building a table from a vector of pairs: insert one pair at a time vs insert_many with 1, 2, 4, ... threads
+void print_bulk_build_performance(int num_elements, int runs) {
+	int max_threads = static_cast<int>(tf::default_num_threads());
+
+	std::cout << "| HASH TABLE BULK BUILD |" << std::endl << std::endl;
+
+	std::vector<std::pair<int, int>> pairs(num_elements);
+	for (int i = 0; i < num_elements; ++i) {
+		pairs[i] = std::make_pair(static_cast<int>(i * 2654435761U), i);
+	}
+
+	long long insert_ms = 0;
+	for (int run = 0; run < runs; ++run) {
+		tf::hash_table<int, int> tf_table;
+
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < num_elements; ++i) {
+			tf_table.insert(pairs[i].first, pairs[i].second);
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		insert_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+	}
+
+	std::cout << "Building a table from " << num_elements << " (int, int) pairs:" << std::endl;
+	std::cout << "tf::hash_table insert: " << insert_ms / runs << " milliseconds" << std::endl;
+
+	for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+		long long bulk_ms = 0;
+		for (int run = 0; run < runs; ++run) {
+			tf::hash_table<int, int> tf_table;
+
+			auto start = std::chrono::high_resolution_clock::now();
+
+			tf_table.insert_many(pairs.begin(), pairs.end(), num_threads);
+
+			auto elapsed = std::chrono::high_resolution_clock::now() - start;
+			bulk_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+		}
+
+		std::cout << "tf::hash_table insert_many (" << num_threads << " thread(s)): " << bulk_ms / runs << " milliseconds" << std::endl;
+	}
+
+	std::cout << std::endl;
+}
+
+// iterating over a full table and over the same table after 90% of the entries were removed
+void print_iteration_performance(int num_elements, int runs) {
+	std::cout << "| HASH TABLE ITERATION |" << std::endl << std::endl;
+
+	tf::hash_table<int, int> tf_table;
+	std::unordered_map<int, int> std_table;
+	for (int i = 0; i < num_elements; ++i) {
+		tf_table.insert(static_cast<int>(i * 2654435761U), i);
+		std_table.insert({ static_cast<int>(i * 2654435761U), i });
+	}
+
+	// prevents the loops from being optimized away
+	long long sum = 0;
+
+	for (int sparse = 0; sparse < 2; ++sparse) {
+		if (sparse) {
+			for (int i = 0; i < num_elements; ++i) {
+				if (i % 10 != 0) {
+					tf_table.remove(static_cast<int>(i * 2654435761U));
+					std_table.erase(static_cast<int>(i * 2654435761U));
+				}
+			}
+		}
+
+		long long tf_ms = 0;
+		long long std_ms = 0;
+
+		for (int run = 0; run < runs; ++run) {
+			// tf
+			auto start = std::chrono::high_resolution_clock::now();
+
+			for (auto it = tf_table.begin(); it.has_value(); ++it) {
+				sum += *it;
+			}
+
+			auto elapsed = std::chrono::high_resolution_clock::now() - start;
+			tf_ms += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+			// std
+			start = std::chrono::high_resolution_clock::now();
+
+			for (auto it = std_table.begin(); it != std_table.end(); ++it) {
+				sum += it->second;
+			}
+
+			elapsed = std::chrono::high_resolution_clock::now() - start;
+			std_ms += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+		}
+
+		std::cout << "Iterating over " << tf_table.size() << " (int, int) pairs" << (sparse ? " after removing 90% of the pairs" : "") << " (checksum " << sum % 10 << "):" << std::endl;
+		std::cout << "tf::hash_table: " << tf_ms / runs << " microseconds" << std::endl;
+		std::cout << "std::unordered_map: " << std_ms / runs << " microseconds" << std::endl << std::endl;
+	}
+}
+
+// contains on a large table where 90% of the lookups miss, with and without a Bloom filter
+void print_bloom_filter_performance(int num_elements, int runs) {
+	const int table_factor = 4;
+	const int num_entries = table_factor * num_elements;
+	const size_t bits_per_entry = 12;
+
+	std::cout << "| HASH TABLE BLOOM FILTER |" << std::endl << std::endl;
+
+	// full table (load factor 1)
+	tf::hash_table<std::string, int> tf_table(num_entries);
+	for (int i = 0; i < num_entries; ++i) {
+		tf_table.insert("key/" + std::to_string(i * 2), i);
+	}
+
+	// every 10th key exists
+	std::vector<std::string> keys(num_elements);
+	for (int i = 0; i < num_elements; ++i) {
+		int k = static_cast<int>((i * 40503ULL) % num_entries);
+		keys[i] = "key/" + std::to_string(k * 2 + (i % 10 != 0));
+	}
+
+	long long plain_ms = 0;
+	long long bloom_ms = 0;
+
+	// prevents the lookups from being optimized away
+	long long found = 0;
+
+	for (int bloom = 0; bloom < 2; ++bloom) {
+		if (bloom)
+			tf_table.set_bloom_filter(bits_per_entry);
+
+		for (int run = 0; run < runs; ++run) {
+			auto start = std::chrono::high_resolution_clock::now();
+
+			for (int i = 0; i < num_elements; ++i) {
+				found += tf_table.contains(keys[i]);
+			}
+
+			auto elapsed = std::chrono::high_resolution_clock::now() - start;
+			(bloom ? bloom_ms : plain_ms) += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+		}
+	}
+
+	// one more pass to count the filter hits and misses
+	tf_table.set_track_statistics(true);
+	for (int i = 0; i < num_elements; ++i) {
+		found += tf_table.contains(keys[i]);
+	}
+	tf::hash_table_statistics stats = tf_table.statistics();
+
+	std::cout << "Looking up " << num_elements << " keys (90% missing) in " << num_entries << " (std::string, int) pairs (" << found / (2 * runs + 1) << " found):" << std::endl;
+	std::cout << "tf::hash_table contains: " << plain_ms / runs << " milliseconds" << std::endl;
+	std::cout << "tf::hash_table contains with Bloom filter (" << bits_per_entry << " bits per entry, " << stats.bloom_filter_bytes / 1024 << " KiB): " << bloom_ms / runs << " milliseconds" << std::endl;
+	std::cout << "Bloom filter: " << stats.bloom_filter_rejections << " of " << stats.bloom_filter_checks << " lookups rejected, "
+		<< stats.bloom_filter_false_positives << " false positives" << std::endl << std::endl;
+}
+
+// slowest single insert while a table grows from a small initial size: tf::hash_table migrates a few chains
+// (and their Bloom filter entries) per insert and gets the new table as lazily zeroed pages, std::unordered_map
+// rehashes all entries at once
+void print_insert_latency_performance(int num_elements, int runs) {
+	const int num_entries = 8 * num_elements;
+
+	std::vector<uint64_t> keys(num_entries);
+	std::mt19937_64 random(42);
+	for (uint64_t &key : keys) {
+		key = random();
+	}
+
+	// returns the slowest insert in microseconds and adds the time of all inserts to total_ms
+	auto worst_insert = [&keys](auto insert, long long &total_ms) {
+		long long worst_us = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (size_t i = 0; i < keys.size(); ++i) {
+			auto insert_start = std::chrono::high_resolution_clock::now();
+			insert(keys[i], i);
+			auto insert_elapsed = std::chrono::high_resolution_clock::now() - insert_start;
+
+			long long us = std::chrono::duration_cast<std::chrono::microseconds>(insert_elapsed).count();
+			if (us > worst_us)
+				worst_us = us;
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		total_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+		return worst_us;
+	};
+
+	long long std_worst_us = 0;
+	long long tf_worst_us = 0;
+	long long bloom_worst_us = 0;
+	long long string_worst_us = 0;
+	long long std_ms = 0;
+	long long tf_ms = 0;
+	long long bloom_ms = 0;
+	long long string_ms = 0;
+
+	for (int run = 0; run < runs; ++run) {
+		std::unordered_map<uint64_t, uint64_t> std_map(1024);
+		long long us = worst_insert([&std_map](uint64_t key, uint64_t value) { std_map.emplace(key, value); }, std_ms);
+		std_worst_us = (us > std_worst_us) ? us : std_worst_us;
+
+		tf::hash_table<uint64_t, uint64_t> tf_table(1024, false);
+		us = worst_insert([&tf_table](uint64_t key, uint64_t value) { tf_table.insert(key, value); }, tf_ms);
+		tf_worst_us = (us > tf_worst_us) ? us : tf_worst_us;
+
+		tf::hash_table<uint64_t, uint64_t> bloom_table(1024, false);
+		bloom_table.set_bloom_filter(12);
+		us = worst_insert([&bloom_table](uint64_t key, uint64_t value) { bloom_table.insert(key, value); }, bloom_ms);
+		bloom_worst_us = (us > bloom_worst_us) ? us : bloom_worst_us;
+
+		// the 8 bytes of the key are the string
+		tf::string_hash_table<uint64_t> string_table(1024);
+		us = worst_insert([&string_table](uint64_t key, uint64_t value) {
+			string_table.insert(std::string_view(reinterpret_cast<const char *>(&key), sizeof(key)), value);
+		}, string_ms);
+		string_worst_us = (us > string_worst_us) ? us : string_worst_us;
+	}
+
+	std::cout << "| HASH TABLE INSERT LATENCY |" << std::endl << std::endl;
+
+	std::cout << "Inserting " << num_entries << " (uint64_t, uint64_t) pairs into tables of initial size 1024 (slowest single insert / all inserts):" << std::endl;
+	std::cout << "std::unordered_map: " << std_worst_us << " microseconds / " << std_ms / runs << " milliseconds" << std::endl;
+	std::cout << "tf::hash_table: " << tf_worst_us << " microseconds / " << tf_ms / runs << " milliseconds" << std::endl;
+	std::cout << "tf::hash_table with Bloom filter (12 bits per entry): " << bloom_worst_us << " microseconds / " << bloom_ms / runs << " milliseconds" << std::endl;
+	std::cout << "tf::string_hash_table (8 character keys): " << string_worst_us << " microseconds / " << string_ms / runs << " milliseconds" << std::endl << std::endl;
+}
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <string>
 #include <map>
+#include <vector>
+#include <utility>
+#include <algorithm>
 #include <chrono>
 #include "../../tfds/tf_search_tree.hpp"
 
@@ -76,3 +79,290 @@ void print_tree_performance(int num_elements, int runs) {
 	std::cout << "std::map: " << std_get_ms << " milliseconds" << std::endl;
 	std::cout << "tf::search_tree: " << tf_get_ms << " milliseconds" << std::endl << std::endl;	
 }
+
+void print_tree_range_performance(int num_elements, int runs) {
+	long long std_range_ms = 0;
+	long long tf_scan_ms = 0;
+	long long tf_range_ms = 0;
+
+	const int num_queries = 1000;
+	const int range_width = 100;
+
+	tf::search_tree<int, int> tf_tree;
+	std::map<int, int> std_map;
+	for (int i = 0; i < num_elements; ++i) {
+		tf_tree.insert(i, i);
+		std_map[i] = i;
+	}
+
+	unsigned long long sum = 0;
+
+	for (int run = 0; run < runs; ++run) {
+		// std
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (int q = 0; q < num_queries; ++q) {
+			int first = static_cast<int>((q * 2654435761U) % num_elements);
+			auto last = std_map.lower_bound(first + range_width);
+			for (auto it = std_map.lower_bound(first); it != last; ++it) {
+				sum += it->second;
+			}
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		std_range_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf, scanning the whole tree (only a tenth of the queries)
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int q = 0; q < num_queries / 10; ++q) {
+			int first = static_cast<int>((q * 2654435761U) % num_elements);
+			for (auto it = tf_tree.begin(); it.has_value(); ++it) {
+				if (it.key() >= first && it.key() < first + range_width)
+					sum += *it;
+			}
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_scan_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() * 10;
+
+		// tf
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int q = 0; q < num_queries; ++q) {
+			int first = static_cast<int>((q * 2654435761U) % num_elements);
+			for (auto it = tf_tree.range(first, first + range_width); it.has_value(); ++it) {
+				sum += *it;
+			}
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_range_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+	}
+
+	std_range_ms /= runs;
+	tf_scan_ms /= runs;
+	tf_range_ms /= runs;
+
+	std::cout << num_queries << " range queries over " << range_width << " of " << num_elements << " keys (checksum " << sum % 10 << "):" << std::endl;
+	std::cout << "std::map (lower_bound): " << std_range_ms << " milliseconds" << std::endl;
+	std::cout << "tf::search_tree (full iteration): " << tf_scan_ms << " milliseconds" << std::endl;
+	std::cout << "tf::search_tree (range): " << tf_range_ms << " milliseconds" << std::endl << std::endl;
+}
+
+void print_tree_percentile_performance(int num_elements, int runs) {
+	long long tf_scan_ms = 0;
+	long long tf_percentile_ms = 0;
+
+	const int num_scan_queries = 10;
+	const int num_queries = 100000;
+
+	// latencies with many duplicates
+	tf::search_tree<int, int> tf_tree(true);
+	for (int i = 0; i < num_elements; ++i) {
+		tf_tree.insert(static_cast<int>((i * 2654435761U) % 100000), i);
+	}
+
+	unsigned long long sum = 0;
+
+	for (int run = 0; run < runs; ++run) {
+		// tf, walking to the position
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (int q = 0; q < num_scan_queries; ++q) {
+			size_t index = static_cast<size_t>(tf_tree.size() * (90 + q % 10) / 100.0);
+			auto it = tf_tree.begin();
+			for (size_t i = 0; i < index; ++i) {
+				++it;
+			}
+			sum += it.key();
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_scan_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// tf
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int q = 0; q < num_queries; ++q) {
+			sum += tf_tree.percentile(90 + q % 10).key();
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_percentile_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+	}
+
+	tf_scan_ms /= runs;
+	tf_percentile_ms /= runs;
+
+	std::cout << "Percentile queries over " << num_elements << " values (checksum " << sum % 10 << "):" << std::endl;
+	std::cout << "tf::search_tree (iteration, " << num_scan_queries << " queries): " << tf_scan_ms << " milliseconds" << std::endl;
+	std::cout << "tf::search_tree (percentile, " << num_queries << " queries): " << tf_percentile_ms << " milliseconds" << std::endl << std::endl;
+}
+
+void print_tree_bulk_build_performance(int num_elements, int runs) {
+	long long tf_insert_ms = 0;
+	long long tf_insert_many_ms = 0;
+	long long tf_sorted_ms = 0;
+	long long tf_copy_ms = 0;
+
+	std::vector<std::pair<int, int>> pairs(num_elements);
+	for (int i = 0; i < num_elements; ++i) {
+		pairs[i] = std::make_pair(static_cast<int>(i * 2654435761U), i);
+	}
+
+	std::vector<std::pair<int, int>> sorted_pairs(pairs);
+	std::sort(sorted_pairs.begin(), sorted_pairs.end());
+
+	for (int run = 0; run < runs; ++run) {
+		// insert
+		auto start = std::chrono::high_resolution_clock::now();
+
+		tf::search_tree<int, int> tf_tree;
+		for (auto &pair : pairs) {
+			tf_tree.insert(pair.first, pair.second);
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_insert_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// insert_many
+		start = std::chrono::high_resolution_clock::now();
+
+		tf::search_tree<int, int> tf_tree2;
+		tf_tree2.insert_many(pairs.begin(), pairs.end());
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_insert_many_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// sorted
+		start = std::chrono::high_resolution_clock::now();
+
+		tf::search_tree<int, int> tf_tree3(sorted_pairs.begin(), sorted_pairs.end());
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_sorted_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// copy
+		start = std::chrono::high_resolution_clock::now();
+
+		tf::search_tree<int, int> tf_tree4(tf_tree);
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_copy_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+	}
+
+	tf_insert_ms /= runs;
+	tf_insert_many_ms /= runs;
+	tf_sorted_ms /= runs;
+	tf_copy_ms /= runs;
+
+	std::cout << "Building a tree from " << num_elements << " (int, int) pairs:" << std::endl;
+	std::cout << "tf::search_tree (insert): " << tf_insert_ms << " milliseconds" << std::endl;
+	std::cout << "tf::search_tree (insert_many): " << tf_insert_many_ms << " milliseconds" << std::endl;
+	std::cout << "tf::search_tree (sorted pairs): " << tf_sorted_ms << " milliseconds" << std::endl;
+	std::cout << "tf::search_tree (copy constructor): " << tf_copy_ms << " milliseconds" << std::endl << std::endl;
+}
+
+void print_tree_set_operation_performance(int num_elements, int runs) {
+	long long tf_insert_ms = 0;
+	long long tf_unite_ms = 0;
+	long long tf_small_insert_ms = 0;
+	long long tf_small_unite_ms = 0;
+	long long tf_subtract_ms = 0;
+
+	const int num_small_elements = 1000;
+
+	for (int run = 0; run < runs; ++run) {
+		tf::search_tree<int, int> tf_tree;
+		tf::search_tree<int, int> tf_tree2;
+		for (int i = 0; i < num_elements; ++i) {
+			tf_tree.insert(2 * i, i);
+			tf_tree2.insert(3 * i, i);
+		}
+
+		tf::search_tree<int, int> tf_small_tree;
+		for (int i = 0; i < num_small_elements; ++i) {
+			tf_small_tree.insert(static_cast<int>((i * 2654435761U) % (3U * num_elements)), i);
+		}
+
+		// union by inserting every entry of the other tree
+		tf::search_tree<int, int> tf_copy(tf_tree);
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (auto it = tf_tree2.begin(); it.has_value(); ++it) {
+			if (!tf_copy.contains(it.key()))
+				tf_copy.insert(it.key(), *it);
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_insert_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// unite
+		tf::search_tree<int, int> tf_copy2(tf_tree);
+		tf::search_tree<int, int> tf_other(tf_tree2);
+		start = std::chrono::high_resolution_clock::now();
+
+		tf_copy2.unite(std::move(tf_other));
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_unite_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// small tree, insert
+		tf::search_tree<int, int> tf_copy3(tf_tree);
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < 100; ++i) {
+			for (auto it = tf_small_tree.begin(); it.has_value(); ++it) {
+				if (!tf_copy3.contains(it.key() + i))
+					tf_copy3.insert(it.key() + i, *it);
+			}
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_small_insert_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// small tree, unite
+		std::vector<tf::search_tree<int, int>> small_trees;
+		for (int i = 0; i < 100; ++i) {
+			small_trees.emplace_back();
+			for (auto it = tf_small_tree.begin(); it.has_value(); ++it) {
+				small_trees.back().insert(it.key() + i, *it);
+			}
+		}
+
+		start = std::chrono::high_resolution_clock::now();
+
+		for (auto &small_tree : small_trees) {
+			tf_tree.unite(std::move(small_tree));
+		}
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_small_unite_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+		// subtract
+		start = std::chrono::high_resolution_clock::now();
+
+		tf_copy2.subtract(tf_tree2);
+
+		elapsed = std::chrono::high_resolution_clock::now() - start;
+		tf_subtract_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+	}
+
+	tf_insert_ms /= runs;
+	tf_unite_ms /= runs;
+	tf_small_insert_ms /= runs;
+	tf_small_unite_ms /= runs;
+	tf_subtract_ms /= runs;
+
+	std::cout << "Union of two trees with " << num_elements << " (int, int) pairs:" << std::endl;
+	std::cout << "tf::search_tree (insert): " << tf_insert_ms << " milliseconds" << std::endl;
+	std::cout << "tf::search_tree (unite): " << tf_unite_ms << " milliseconds" << std::endl << std::endl;
+
+	std::cout << "Union of 100 trees with " << num_small_elements << " pairs into a tree with " << num_elements << " pairs:" << std::endl;
+	std::cout << "tf::search_tree (insert): " << tf_small_insert_ms << " milliseconds" << std::endl;
+	std::cout << "tf::search_tree (unite): " << tf_small_unite_ms << " milliseconds" << std::endl << std::endl;
+
+	std::cout << "Difference of two trees with " << num_elements << " (int, int) pairs:" << std::endl;
+	std::cout << "tf::search_tree (subtract): " << tf_subtract_ms << " milliseconds" << std::endl << std::endl;
+}
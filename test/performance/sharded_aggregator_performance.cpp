@@ -0,0 +1,70 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../../tfds/tf_hash_table.hpp"
+#include "../../tfds/tf_sharded_aggregator.hpp"
+
+// merging the counts of num_workers workers: a serial loop into one hash_table vs sharded_aggregator::merge
+void print_aggregator_performance(int num_elements, int runs) {
+	const int num_workers = 8;
+	const int num_keys = num_elements / 2;
+	int max_threads = static_cast<int>(tf::default_num_threads());
+
+	std::cout << "| SHARDED AGGREGATOR |" << std::endl << std::endl;
+
+	// every worker counts num_elements / num_workers keys
+	auto key_of = [num_keys](int worker, int i) { return static_cast<int>(((i * 2654435761ULL) + worker * 40503ULL) % num_keys); };
+	int adds_per_worker = num_elements / num_workers;
+
+	long long serial_ms = 0;
+	for (int run = 0; run < runs; ++run) {
+		std::vector<tf::hash_table<int, long long>> worker_tables(num_workers);
+		for (int w = 0; w < num_workers; ++w) {
+			for (int i = 0; i < adds_per_worker; ++i) {
+				worker_tables[w].insert_or_combine(key_of(w, i), 1LL, std::plus<long long>());
+			}
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+
+		tf::hash_table<int, long long> merged;
+		for (int w = 0; w < num_workers; ++w) {
+			for (auto it = worker_tables[w].begin(); it.has_value(); ++it) {
+				if (merged.contains(it.key()))
+					merged[it.key()] += *it;
+				else
+					merged.insert(it.key(), *it);
+			}
+		}
+
+		auto elapsed = std::chrono::high_resolution_clock::now() - start;
+		serial_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+	}
+
+	std::cout << "Merging the (int, long long) counts of " << num_workers << " workers (" << num_elements << " adds, " << num_keys << " keys):" << std::endl;
+	std::cout << "tf::hash_table serial merge: " << serial_ms / runs << " milliseconds" << std::endl;
+
+	for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+		long long merge_ms = 0;
+		for (int run = 0; run < runs; ++run) {
+			tf::sharded_aggregator<int, long long> aggregator(num_workers, 4 * num_workers);
+			for (int w = 0; w < num_workers; ++w) {
+				for (int i = 0; i < adds_per_worker; ++i) {
+					aggregator.add(w, key_of(w, i), 1LL);
+				}
+			}
+
+			auto start = std::chrono::high_resolution_clock::now();
+
+			aggregator.merge(num_threads);
+
+			auto elapsed = std::chrono::high_resolution_clock::now() - start;
+			merge_ms += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+		}
+
+		std::cout << "tf::sharded_aggregator merge (" << num_threads << " thread(s)): " << merge_ms / runs << " milliseconds" << std::endl;
+	}
+
+	std::cout << std::endl;
+}
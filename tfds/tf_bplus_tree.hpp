@@ -0,0 +1,1054 @@
+#ifndef TF_BPLUS_TREE_H
+#define TF_BPLUS_TREE_H
+
+#include <algorithm> // std::swap, std::move, std::move_backward, std::copy
+#include <type_traits> // std::enable_if, std::decay, std::is_arithmetic
+#include <utility> // std::move
+#include "utils/tf_exception.hpp"
+#include "utils/tf_compare_functions.hpp"
+
+namespace tf {
+
+/*
+* Ordered map (B+ tree). The keys and values are stored in arrays inside the nodes, which are a few
+* cache lines large, and the leaves are linked for iteration. Keys and values have to be default
+* constructible and movable. Keys are unique.
+*/
+template <typename K, typename V>
+class bplus_tree {
+private:
+    // NODES
+
+    // size of the key/value (leaf) or key/child (inner node) arrays of a node in bytes
+    static const size_t node_bytes = 512;
+
+    static constexpr size_t capacity(const size_t entry_size) {
+        return (node_bytes / entry_size > 4) ? node_bytes / entry_size : 4;
+    }
+
+    struct node {
+        bool is_leaf;
+        size_t count;
+
+        node(const bool is_leaf):
+            is_leaf(is_leaf), count(0) {}
+    };
+
+    struct inner_node;
+
+    static const size_t leaf_capacity = capacity(sizeof(K) + sizeof(V));
+    static const size_t inner_capacity = capacity(sizeof(K) + sizeof(node *));
+
+    // fewer entries/keys than this (except in the root) are merged with or filled from a sibling
+    static const size_t min_leaf_count = leaf_capacity / 2;
+    static const size_t min_inner_count = (inner_capacity - 1) / 2;
+
+    // a tree with fan-out >= 2 and less than 2^64 entries is never deeper than this
+    static const size_t max_depth = 64;
+
+    struct leaf_node : node {
+        leaf_node *previous;
+        leaf_node *next;
+        K keys[leaf_capacity];
+        V values[leaf_capacity];
+
+        leaf_node():
+            node(true), previous(nullptr), next(nullptr) {}
+    };
+
+    // all keys of children[i] are < keys[i] <= all keys of children[i + 1]
+    struct inner_node : node {
+        K keys[inner_capacity];
+        node *children[inner_capacity + 1];
+
+        inner_node():
+            node(false) {}
+    };
+
+    static leaf_node *as_leaf(node *n) {
+        return static_cast<leaf_node *>(n);
+    }
+
+    static inner_node *as_inner(node *n) {
+        return static_cast<inner_node *>(n);
+    }
+
+    void destroy_subtree(node *n) {
+        if (n->is_leaf) {
+            delete as_leaf(n);
+            return;
+        }
+
+        inner_node *inner = as_inner(n);
+        for (size_t i = 0; i <= inner->count; ++i) {
+            destroy_subtree(inner->children[i]);
+        }
+
+        delete inner;
+    }
+
+    // O(size of the subtree): copies the subtree with the same shape, the copied leaves are linked behind
+    // previous_leaf. If copying a key or value throws, the nodes copied so far are freed
+    node *clone_subtree(const node *n, leaf_node *&previous_leaf) {
+        if (n->is_leaf) {
+            const leaf_node *other = static_cast<const leaf_node *>(n);
+            leaf_node *leaf = new leaf_node();
+            try {
+                std::copy(other->keys, other->keys + other->count, leaf->keys);
+                std::copy(other->values, other->values + other->count, leaf->values);
+            }
+            catch (...) {
+                delete leaf;
+                throw;
+            }
+
+            leaf->count = other->count;
+            leaf->previous = previous_leaf;
+            if (previous_leaf)
+                previous_leaf->next = leaf;
+
+            previous_leaf = leaf;
+            return leaf;
+        }
+
+        const inner_node *other = static_cast<const inner_node *>(n);
+        inner_node *inner = new inner_node();
+        size_t num_children = 0;
+        try {
+            std::copy(other->keys, other->keys + other->count, inner->keys);
+            for (; num_children <= other->count; ++num_children) {
+                inner->children[num_children] = clone_subtree(other->children[num_children], previous_leaf);
+            }
+        }
+        catch (...) {
+            for (size_t i = 0; i < num_children; ++i) {
+                destroy_subtree(inner->children[i]);
+            }
+
+            delete inner;
+            throw;
+        }
+
+        inner->count = other->count;
+        return inner;
+    }
+
+    // SEARCH
+
+    static bool key_less_than(const K &key, const K &other) {
+        return less_than<K>(key, other);
+    }
+
+    template <typename Q>
+    static bool key_less_than(const Q &key, const K &other) {
+        return less_than(key, other);
+    }
+
+    static bool key_greater_than(const K &key, const K &other) {
+        return greater_than<K>(key, other);
+    }
+
+    template <typename Q>
+    static bool key_greater_than(const Q &key, const K &other) {
+        return greater_than(key, other);
+    }
+
+    // number of keys in keys[0, count) that are smaller than key (compare_equal = false)
+    // or smaller than or equal to key (compare_equal = true)
+    template <typename Q>
+    static size_t count_smaller(const K *keys, const size_t count, const Q &key, const bool compare_equal) {
+        if constexpr (std::is_arithmetic<K>::value && std::is_same<Q, K>::value) {
+            // branch free linear scan, which the compiler can vectorize
+            size_t result = 0;
+            if (compare_equal) {
+                for (size_t i = 0; i < count; ++i) {
+                    result += (keys[i] <= key);
+                }
+            }
+            else {
+                for (size_t i = 0; i < count; ++i) {
+                    result += (keys[i] < key);
+                }
+            }
+
+            return result;
+        }
+        else {
+            // binary search, comparisons of other keys can be expensive
+            size_t low = 0;
+            size_t high = count;
+            while (low < high) {
+                size_t middle = low + (high - low) / 2;
+                bool smaller = (compare_equal) ? !key_less_than(key, keys[middle]) : key_greater_than(key, keys[middle]);
+                if (smaller)
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+
+            return low;
+        }
+    }
+
+    // index of the child of an inner node that can contain the key
+    template <typename Q>
+    static size_t child_index(const inner_node *inner, const Q &key) {
+        return count_smaller(inner->keys, inner->count, key, true);
+    }
+
+    // position of the first key >= key in a leaf
+    template <typename Q>
+    static size_t leaf_position(const leaf_node *leaf, const Q &key) {
+        return count_smaller(leaf->keys, leaf->count, key, false);
+    }
+
+    template <typename Q>
+    static bool key_at_equals(const leaf_node *leaf, const size_t position, const Q &key) {
+        return position < leaf->count && !key_less_than(key, leaf->keys[position]);
+    }
+
+    template <typename Q>
+    leaf_node *find_leaf(const Q &key) const {
+        node *n = root;
+        while (!n->is_leaf) {
+            inner_node *inner = as_inner(n);
+            n = inner->children[child_index(inner, key)];
+        }
+
+        return as_leaf(n);
+    }
+
+    // value with the key, nullptr if not found
+    template <typename Q>
+    V *find_value(const Q &key) const {
+        if (!root)
+            return nullptr;
+
+        leaf_node *leaf = find_leaf(key);
+        size_t position = leaf_position(leaf, key);
+        return (key_at_equals(leaf, position, key)) ? &leaf->values[position] : nullptr;
+    }
+
+    // leaf and index of the first entry with a key >= key (compare_equal = false) or > key (compare_equal = true),
+    // nullptr if there is none. All keys of the following leaves are larger than the key, so the entry is in the
+    // leaf that find_leaf returns or is the first one of the next leaf
+    template <typename Q>
+    leaf_node *bound_leaf(const Q &key, const bool compare_equal, size_t &index) const {
+        index = 0;
+        if (!root)
+            return nullptr;
+
+        leaf_node *leaf = find_leaf(key);
+        index = count_smaller(leaf->keys, leaf->count, key, compare_equal);
+        while (leaf && index == leaf->count) {
+            leaf = leaf->next;
+            index = 0;
+        }
+
+        return leaf;
+    }
+
+    // leaf and index of the entry with the key, nullptr if not found
+    template <typename Q>
+    leaf_node *find_entry(const Q &key, size_t &index) const {
+        leaf_node *leaf = bound_leaf(key, false, index);
+        return (leaf && key_at_equals(leaf, index, key)) ? leaf : nullptr;
+    }
+
+    // first entry of the range [first, last) or nullptr if the range is empty, stop: first entry after the range
+    template <typename Q>
+    leaf_node *range_entries(const Q &first, const Q &last, size_t &first_index, leaf_node *&stop_leaf, size_t &stop_index) const {
+        leaf_node *leaf = bound_leaf(first, false, first_index);
+        if (!leaf || !key_greater_than(last, leaf->keys[first_index]))
+            return nullptr;
+
+        stop_leaf = bound_leaf(last, false, stop_index);
+        return leaf;
+    }
+
+    // the inner nodes on the way from the root to a leaf and the child index taken in each of them
+    struct path {
+        inner_node *nodes[max_depth];
+        size_t indices[max_depth];
+        size_t depth;
+    };
+
+    template <typename Q>
+    leaf_node *find_leaf(const Q &key, path &p) const {
+        p.depth = 0;
+        node *n = root;
+        while (!n->is_leaf) {
+            inner_node *inner = as_inner(n);
+            size_t index = child_index(inner, key);
+            p.nodes[p.depth] = inner;
+            p.indices[p.depth] = index;
+            ++p.depth;
+            n = inner->children[index];
+        }
+
+        return as_leaf(n);
+    }
+
+    // INSERT
+
+    // inserts the key and the right child (that follows the key) at the end of the path, splits full nodes upward
+    void insert_into_parent(path &p, K separator, node *right) {
+        while (p.depth > 0) {
+            --p.depth;
+            inner_node *inner = p.nodes[p.depth];
+            size_t position = p.indices[p.depth];
+
+            if (inner->count < inner_capacity) {
+                insert_into_inner(inner, position, std::move(separator), right);
+                return;
+            }
+
+            // the middle key moves up, the upper keys move into a new node
+            size_t middle = inner_capacity / 2;
+            inner_node *new_inner = new inner_node();
+            new_inner->count = inner_capacity - middle - 1;
+            std::move(inner->keys + middle + 1, inner->keys + inner_capacity, new_inner->keys);
+            std::copy(inner->children + middle + 1, inner->children + inner_capacity + 1, new_inner->children);
+            K up = std::move(inner->keys[middle]);
+            inner->count = middle;
+
+            if (position <= middle)
+                insert_into_inner(inner, position, std::move(separator), right);
+            else
+                insert_into_inner(new_inner, position - middle - 1, std::move(separator), right);
+
+            separator = std::move(up);
+            right = new_inner;
+        }
+
+        // the root was split
+        inner_node *new_root = new inner_node();
+        new_root->count = 1;
+        new_root->keys[0] = std::move(separator);
+        new_root->children[0] = root;
+        new_root->children[1] = right;
+        root = new_root;
+    }
+
+    static void insert_into_inner(inner_node *inner, const size_t position, K &&separator, node *right) {
+        std::move_backward(inner->keys + position, inner->keys + inner->count, inner->keys + inner->count + 1);
+        std::copy_backward(inner->children + position + 1, inner->children + inner->count + 1, inner->children + inner->count + 2);
+        inner->keys[position] = std::move(separator);
+        inner->children[position + 1] = right;
+        ++inner->count;
+    }
+
+    template <typename KK, typename VV>
+    static void insert_into_leaf(leaf_node *leaf, const size_t position, KK &&key, VV &&value) {
+        std::move_backward(leaf->keys + position, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        std::move_backward(leaf->values + position, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+        leaf->keys[position] = std::forward<KK>(key);
+        leaf->values[position] = std::forward<VV>(value);
+        ++leaf->count;
+    }
+
+    template <typename KK, typename VV>
+    void insert_entry(KK &&key, VV &&value) {
+        if (!root) {
+            leaf_node *leaf = new leaf_node();
+            insert_into_leaf(leaf, 0, std::forward<KK>(key), std::forward<VV>(value));
+            root = first_leaf = last_leaf = leaf;
+            ++size_;
+            return;
+        }
+
+        path p;
+        leaf_node *leaf = find_leaf(key, p);
+        size_t position = leaf_position(leaf, key);
+        if (key_at_equals(leaf, position, key))
+            throw exception("b+ tree: insert: key already exists");
+
+        if (leaf->count < leaf_capacity) {
+            insert_into_leaf(leaf, position, std::forward<KK>(key), std::forward<VV>(value));
+            ++size_;
+            return;
+        }
+
+        // the upper half moves into a new leaf on the right
+        size_t middle = leaf_capacity / 2;
+        leaf_node *new_leaf = new leaf_node();
+        new_leaf->count = leaf_capacity - middle;
+        std::move(leaf->keys + middle, leaf->keys + leaf_capacity, new_leaf->keys);
+        std::move(leaf->values + middle, leaf->values + leaf_capacity, new_leaf->values);
+        leaf->count = middle;
+
+        new_leaf->previous = leaf;
+        new_leaf->next = leaf->next;
+        if (leaf->next)
+            leaf->next->previous = new_leaf;
+        else
+            last_leaf = new_leaf;
+        leaf->next = new_leaf;
+
+        if (position <= middle)
+            insert_into_leaf(leaf, position, std::forward<KK>(key), std::forward<VV>(value));
+        else
+            insert_into_leaf(new_leaf, position - middle, std::forward<KK>(key), std::forward<VV>(value));
+
+        ++size_;
+        insert_into_parent(p, new_leaf->keys[0], new_leaf);
+    }
+
+    // REMOVE
+
+    static void remove_from_leaf(leaf_node *leaf, const size_t position) {
+        std::move(leaf->keys + position + 1, leaf->keys + leaf->count, leaf->keys + position);
+        std::move(leaf->values + position + 1, leaf->values + leaf->count, leaf->values + position);
+        --leaf->count;
+    }
+
+    // removes keys[position] and children[position + 1]
+    static void remove_from_inner(inner_node *inner, const size_t position) {
+        std::move(inner->keys + position + 1, inner->keys + inner->count, inner->keys + position);
+        std::copy(inner->children + position + 2, inner->children + inner->count + 1, inner->children + position + 1);
+        --inner->count;
+    }
+
+    // moves all entries of right into left (its left neighbour) and deletes right
+    void merge_leaves(leaf_node *left, leaf_node *right) {
+        std::move(right->keys, right->keys + right->count, left->keys + left->count);
+        std::move(right->values, right->values + right->count, left->values + left->count);
+        left->count += right->count;
+
+        left->next = right->next;
+        if (right->next)
+            right->next->previous = left;
+        else
+            last_leaf = left;
+
+        delete right;
+    }
+
+    // moves the separator and all keys and children of right into left and deletes right
+    static void merge_inner_nodes(inner_node *left, K &&separator, inner_node *right) {
+        left->keys[left->count] = std::move(separator);
+        std::move(right->keys, right->keys + right->count, left->keys + left->count + 1);
+        std::copy(right->children, right->children + right->count + 1, left->children + left->count + 1);
+        left->count += right->count + 1;
+        delete right;
+    }
+
+    // refills or merges the leaf at the end of the path that has less than min_leaf_count entries
+    void rebalance_leaf(path &p, leaf_node *leaf) {
+        inner_node *parent = p.nodes[p.depth - 1];
+        size_t index = p.indices[p.depth - 1];
+        leaf_node *left = (index > 0) ? as_leaf(parent->children[index - 1]) : nullptr;
+        leaf_node *right = (index < parent->count) ? as_leaf(parent->children[index + 1]) : nullptr;
+
+        if (left && left->count > min_leaf_count) {
+            insert_into_leaf(leaf, 0, std::move(left->keys[left->count - 1]), std::move(left->values[left->count - 1]));
+            --left->count;
+            parent->keys[index - 1] = leaf->keys[0];
+            return;
+        }
+
+        if (right && right->count > min_leaf_count) {
+            insert_into_leaf(leaf, leaf->count, std::move(right->keys[0]), std::move(right->values[0]));
+            remove_from_leaf(right, 0);
+            parent->keys[index] = right->keys[0];
+            return;
+        }
+
+        if (left) {
+            merge_leaves(left, leaf);
+            remove_from_inner(parent, index - 1);
+        }
+        else {
+            merge_leaves(leaf, right);
+            remove_from_inner(parent, index);
+        }
+
+        --p.depth;
+        rebalance_inner(p, parent);
+    }
+
+    // refills or merges inner nodes with less than min_inner_count keys upward, shrinks the tree at the root
+    void rebalance_inner(path &p, inner_node *inner) {
+        while (true) {
+            if (p.depth == 0) {
+                if (inner->count == 0) {
+                    root = inner->children[0];
+                    delete inner;
+                }
+
+                return;
+            }
+
+            if (inner->count >= min_inner_count)
+                return;
+
+            inner_node *parent = p.nodes[p.depth - 1];
+            size_t index = p.indices[p.depth - 1];
+            inner_node *left = (index > 0) ? as_inner(parent->children[index - 1]) : nullptr;
+            inner_node *right = (index < parent->count) ? as_inner(parent->children[index + 1]) : nullptr;
+
+            // rotate a key through the parent
+            if (left && left->count > min_inner_count) {
+                std::move_backward(inner->keys, inner->keys + inner->count, inner->keys + inner->count + 1);
+                std::copy_backward(inner->children, inner->children + inner->count + 1, inner->children + inner->count + 2);
+                inner->keys[0] = std::move(parent->keys[index - 1]);
+                inner->children[0] = left->children[left->count];
+                parent->keys[index - 1] = std::move(left->keys[left->count - 1]);
+                --left->count;
+                ++inner->count;
+                return;
+            }
+
+            if (right && right->count > min_inner_count) {
+                inner->keys[inner->count] = std::move(parent->keys[index]);
+                inner->children[inner->count + 1] = right->children[0];
+                ++inner->count;
+                parent->keys[index] = std::move(right->keys[0]);
+                std::move(right->keys + 1, right->keys + right->count, right->keys);
+                std::copy(right->children + 1, right->children + right->count + 1, right->children);
+                --right->count;
+                return;
+            }
+
+            if (left) {
+                merge_inner_nodes(left, std::move(parent->keys[index - 1]), inner);
+                remove_from_inner(parent, index - 1);
+            }
+            else {
+                merge_inner_nodes(inner, std::move(parent->keys[index]), right);
+                remove_from_inner(parent, index);
+            }
+
+            --p.depth;
+            inner = parent;
+        }
+    }
+
+    template <typename Q>
+    V remove_entry(const Q &key, const char *error) {
+        if (!root)
+            throw exception(error);
+
+        path p;
+        leaf_node *leaf = find_leaf(key, p);
+        size_t position = leaf_position(leaf, key);
+        if (!key_at_equals(leaf, position, key))
+            throw exception(error);
+
+        V result = std::move(leaf->values[position]);
+        remove_from_leaf(leaf, position);
+        --size_;
+
+        if (p.depth == 0) {
+            if (leaf->count == 0) {
+                delete leaf;
+                root = first_leaf = last_leaf = nullptr;
+            }
+        }
+        else if (leaf->count < min_leaf_count) {
+            rebalance_leaf(p, leaf);
+        }
+
+        return result;
+    }
+
+    // enables the lookup overloads for types that are compared without constructing a K (see is_lookup_key)
+    template <typename Q>
+    using if_lookup_key = typename std::enable_if<is_lookup_key<K, typename std::decay<Q>::type>::value, int>::type;
+
+    // VARIABLES
+
+    size_t size_;
+    node *root;
+    leaf_node *first_leaf;
+    leaf_node *last_leaf;
+
+public:
+    // ITERATORS
+
+    class iterator {
+    private:
+        friend class bplus_tree;
+
+        leaf_node *current_leaf;
+        size_t current_index;
+        // iterators over a range have no value before the first entry (--) or at the stop entry (++), nullptr: no limit
+        leaf_node *first_leaf;
+        size_t first_index;
+        leaf_node *stop_leaf;
+        size_t stop_index;
+
+        iterator(leaf_node *leaf, const size_t index, leaf_node *first_leaf, const size_t first_index, leaf_node *stop_leaf, const size_t stop_index):
+            current_leaf(leaf),
+            current_index(index),
+            first_leaf(first_leaf),
+            first_index(first_index),
+            stop_leaf(stop_leaf),
+            stop_index(stop_index) {}
+
+    public:
+        iterator(leaf_node *leaf, const size_t index):
+            iterator(leaf, index, nullptr, 0, nullptr, 0) {}
+
+        const K &key() const { return current_leaf->keys[current_index]; }
+        V &operator*() { return current_leaf->values[current_index]; }
+        V &value() { return current_leaf->values[current_index]; }
+
+        void operator++() {
+            if (++current_index == current_leaf->count) {
+                current_leaf = current_leaf->next;
+                current_index = 0;
+            }
+
+            if (current_leaf == stop_leaf && current_index == stop_index)
+                current_leaf = nullptr;
+        }
+
+        void operator--() {
+            if (current_leaf == first_leaf && current_index == first_index) {
+                current_leaf = nullptr;
+                return;
+            }
+
+            if (current_index == 0) {
+                current_leaf = current_leaf->previous;
+                current_index = (current_leaf) ? current_leaf->count : 0;
+            }
+
+            --current_index;
+        }
+
+        bool has_value() const { return current_leaf != nullptr; }
+    };
+
+    class const_iterator {
+    private:
+        friend class bplus_tree;
+
+        const leaf_node *current_leaf;
+        size_t current_index;
+        // iterators over a range have no value before the first entry (--) or at the stop entry (++), nullptr: no limit
+        const leaf_node *first_leaf;
+        size_t first_index;
+        const leaf_node *stop_leaf;
+        size_t stop_index;
+
+        const_iterator(const leaf_node *leaf, const size_t index, const leaf_node *first_leaf, const size_t first_index, const leaf_node *stop_leaf, const size_t stop_index):
+            current_leaf(leaf),
+            current_index(index),
+            first_leaf(first_leaf),
+            first_index(first_index),
+            stop_leaf(stop_leaf),
+            stop_index(stop_index) {}
+
+    public:
+        const_iterator(const leaf_node *leaf, const size_t index):
+            const_iterator(leaf, index, nullptr, 0, nullptr, 0) {}
+
+        const K &key() const { return current_leaf->keys[current_index]; }
+        const V &operator*() const { return current_leaf->values[current_index]; }
+        const V &value() const { return current_leaf->values[current_index]; }
+
+        void operator++() {
+            if (++current_index == current_leaf->count) {
+                current_leaf = current_leaf->next;
+                current_index = 0;
+            }
+
+            if (current_leaf == stop_leaf && current_index == stop_index)
+                current_leaf = nullptr;
+        }
+
+        void operator--() {
+            if (current_leaf == first_leaf && current_index == first_index) {
+                current_leaf = nullptr;
+                return;
+            }
+
+            if (current_index == 0) {
+                current_leaf = current_leaf->previous;
+                current_index = (current_leaf) ? current_leaf->count : 0;
+            }
+
+            --current_index;
+        }
+
+        bool has_value() const { return current_leaf != nullptr; }
+    };
+
+    // CLASS
+
+    // constructor
+    bplus_tree():
+        size_(0),
+        root(nullptr),
+        first_leaf(nullptr),
+        last_leaf(nullptr) {}
+
+    // copy constructor (O(n): the nodes are copied with their shape, so the copy is as full as the original)
+    bplus_tree(const bplus_tree &other):
+        bplus_tree()
+    {
+        if (!other.root)
+            return;
+
+        leaf_node *previous_leaf = nullptr;
+        root = clone_subtree(other.root, previous_leaf);
+        last_leaf = previous_leaf;
+
+        node *n = root;
+        while (!n->is_leaf) {
+            n = as_inner(n)->children[0];
+        }
+        first_leaf = as_leaf(n);
+        size_ = other.size_;
+    }
+
+    // destructor
+    ~bplus_tree() {
+        clear();
+    }
+
+    friend void swap(bplus_tree &first, bplus_tree &second) noexcept {
+        using std::swap;
+        swap(first.size_, second.size_);
+        swap(first.root, second.root);
+        swap(first.first_leaf, second.first_leaf);
+        swap(first.last_leaf, second.last_leaf);
+    }
+
+    // move constructor
+    bplus_tree(bplus_tree &&other) noexcept : bplus_tree() {
+        swap(*this, other);
+    }
+
+    // copy assignment operator
+    bplus_tree &operator=(bplus_tree other) {
+        swap(*this, other);
+        return *this;
+    }
+
+    // O(log(n))
+    void insert(const K &key, const V &value) {
+        insert_entry(key, value);
+    }
+
+    // O(log(n))
+    void insert(K &&key, V &&value) {
+        insert_entry(std::move(key), std::move(value));
+    }
+
+    // O(log(n))
+    const V &get(const K &key) const {
+        V *value = find_value(key);
+        if (!value)
+            throw exception("b+ tree: get: key not found");
+
+        return *value;
+    }
+
+    // O(log(n))
+    V &operator[](const K &key) {
+        V *value = find_value(key);
+        if (!value)
+            throw exception("b+ tree: []: key not found");
+
+        return *value;
+    }
+
+    // O(log(n))
+    const V &operator[](const K &key) const {
+        V *value = find_value(key);
+        if (!value)
+            throw exception("b+ tree: []: key not found");
+
+        return *value;
+    }
+
+    // O(1)
+    V &min() {
+        if (empty())
+            throw exception("b+ tree: min: tree is empty");
+
+        return first_leaf->values[0];
+    }
+
+    // O(1)
+    const V &min() const {
+        if (empty())
+            throw exception("b+ tree: min: tree is empty");
+
+        return first_leaf->values[0];
+    }
+
+    // O(1)
+    V &max() {
+        if (empty())
+            throw exception("b+ tree: max: tree is empty");
+
+        return last_leaf->values[last_leaf->count - 1];
+    }
+
+    // O(1)
+    const V &max() const {
+        if (empty())
+            throw exception("b+ tree: max: tree is empty");
+
+        return last_leaf->values[last_leaf->count - 1];
+    }
+
+    // O(log(n))
+    V pop_min() {
+        if (empty())
+            throw exception("b+ tree: pop_min: tree is empty");
+
+        K key = first_leaf->keys[0];
+        return remove_entry(key, "b+ tree: pop_min: tree is empty");
+    }
+
+    // O(log(n))
+    V pop_max() {
+        if (empty())
+            throw exception("b+ tree: pop_max: tree is empty");
+
+        K key = last_leaf->keys[last_leaf->count - 1];
+        return remove_entry(key, "b+ tree: pop_max: tree is empty");
+    }
+
+    // O(log(n))
+    V remove(const K &key) {
+        return remove_entry(key, "b+ tree: remove: key not found");
+    }
+
+    // O(log(n))
+    bool contains(const K &key) const {
+        return find_value(key) != nullptr;
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    const V &get(const Q &key) const {
+        V *value = find_value(key);
+        if (!value)
+            throw exception("b+ tree: get: key not found");
+
+        return *value;
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    V &operator[](const Q &key) {
+        V *value = find_value(key);
+        if (!value)
+            throw exception("b+ tree: []: key not found");
+
+        return *value;
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    const V &operator[](const Q &key) const {
+        V *value = find_value(key);
+        if (!value)
+            throw exception("b+ tree: []: key not found");
+
+        return *value;
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    V remove(const Q &key) {
+        return remove_entry(key, "b+ tree: remove: key not found");
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    bool contains(const Q &key) const {
+        return find_value(key) != nullptr;
+    }
+
+    // O(log(n)): iterator at the entry with the key (no value if the key does not exist)
+    iterator find(const K &key) {
+        size_t index;
+        leaf_node *leaf = find_entry(key, index);
+        return iterator(leaf, index);
+    }
+
+    // O(log(n)): iterator at the first entry with a key >= key (no value if there is none)
+    iterator lower_bound(const K &key) {
+        size_t index;
+        leaf_node *leaf = bound_leaf(key, false, index);
+        return iterator(leaf, index);
+    }
+
+    // O(log(n)): iterator at the first entry with a key > key (no value if there is none)
+    iterator upper_bound(const K &key) {
+        size_t index;
+        leaf_node *leaf = bound_leaf(key, true, index);
+        return iterator(leaf, index);
+    }
+
+    // O(log(n) + k): iterator over the k entries with first <= key < last, which has no value
+    // after the last entry of the range (++) or before the first one (--)
+    iterator range(const K &first, const K &last) {
+        size_t first_index;
+        leaf_node *stop_leaf = nullptr;
+        size_t stop_index = 0;
+        leaf_node *leaf = range_entries(first, last, first_index, stop_leaf, stop_index);
+        return iterator(leaf, first_index, leaf, first_index, stop_leaf, stop_index);
+    }
+
+    // O(log(n)): iterator at the entry with the key (no value if the key does not exist)
+    const_iterator find(const K &key) const {
+        size_t index;
+        leaf_node *leaf = find_entry(key, index);
+        return const_iterator(leaf, index);
+    }
+
+    // O(log(n)): iterator at the first entry with a key >= key (no value if there is none)
+    const_iterator lower_bound(const K &key) const {
+        size_t index;
+        leaf_node *leaf = bound_leaf(key, false, index);
+        return const_iterator(leaf, index);
+    }
+
+    // O(log(n)): iterator at the first entry with a key > key (no value if there is none)
+    const_iterator upper_bound(const K &key) const {
+        size_t index;
+        leaf_node *leaf = bound_leaf(key, true, index);
+        return const_iterator(leaf, index);
+    }
+
+    // O(log(n) + k): iterator over the k entries with first <= key < last, which has no value
+    // after the last entry of the range (++) or before the first one (--)
+    const_iterator range(const K &first, const K &last) const {
+        size_t first_index;
+        leaf_node *stop_leaf = nullptr;
+        size_t stop_index = 0;
+        leaf_node *leaf = range_entries(first, last, first_index, stop_leaf, stop_index);
+        return const_iterator(leaf, first_index, leaf, first_index, stop_leaf, stop_index);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: iterator at the entry with the key (no value if the key does not exist)
+    template <typename Q, if_lookup_key<Q> = 0>
+    iterator find(const Q &key) {
+        size_t index;
+        leaf_node *leaf = find_entry(key, index);
+        return iterator(leaf, index);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: iterator at the first entry with a key >= key (no value if there is none)
+    template <typename Q, if_lookup_key<Q> = 0>
+    iterator lower_bound(const Q &key) {
+        size_t index;
+        leaf_node *leaf = bound_leaf(key, false, index);
+        return iterator(leaf, index);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: iterator at the first entry with a key > key (no value if there is none)
+    template <typename Q, if_lookup_key<Q> = 0>
+    iterator upper_bound(const Q &key) {
+        size_t index;
+        leaf_node *leaf = bound_leaf(key, true, index);
+        return iterator(leaf, index);
+    }
+
+    // O(log(n) + k), key: std::string_view, C string or other lookup key: iterator over the k entries with first <= key < last, which has no value
+    // after the last entry of the range (++) or before the first one (--)
+    template <typename Q, if_lookup_key<Q> = 0>
+    iterator range(const Q &first, const Q &last) {
+        size_t first_index;
+        leaf_node *stop_leaf = nullptr;
+        size_t stop_index = 0;
+        leaf_node *leaf = range_entries(first, last, first_index, stop_leaf, stop_index);
+        return iterator(leaf, first_index, leaf, first_index, stop_leaf, stop_index);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: iterator at the entry with the key (no value if the key does not exist)
+    template <typename Q, if_lookup_key<Q> = 0>
+    const_iterator find(const Q &key) const {
+        size_t index;
+        leaf_node *leaf = find_entry(key, index);
+        return const_iterator(leaf, index);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: iterator at the first entry with a key >= key (no value if there is none)
+    template <typename Q, if_lookup_key<Q> = 0>
+    const_iterator lower_bound(const Q &key) const {
+        size_t index;
+        leaf_node *leaf = bound_leaf(key, false, index);
+        return const_iterator(leaf, index);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: iterator at the first entry with a key > key (no value if there is none)
+    template <typename Q, if_lookup_key<Q> = 0>
+    const_iterator upper_bound(const Q &key) const {
+        size_t index;
+        leaf_node *leaf = bound_leaf(key, true, index);
+        return const_iterator(leaf, index);
+    }
+
+    // O(log(n) + k), key: std::string_view, C string or other lookup key: iterator over the k entries with first <= key < last, which has no value
+    // after the last entry of the range (++) or before the first one (--)
+    template <typename Q, if_lookup_key<Q> = 0>
+    const_iterator range(const Q &first, const Q &last) const {
+        size_t first_index;
+        leaf_node *stop_leaf = nullptr;
+        size_t stop_index = 0;
+        leaf_node *leaf = range_entries(first, last, first_index, stop_leaf, stop_index);
+        return const_iterator(leaf, first_index, leaf, first_index, stop_leaf, stop_index);
+    }
+
+    // O(n)
+    void clear() {
+        if (root)
+            destroy_subtree(root);
+
+        root = first_leaf = last_leaf = nullptr;
+        size_ = 0;
+    }
+
+    // O(1)
+    size_t size() const {
+        return size_;
+    }
+
+    // O(log(n)): number of levels (0 if the tree is empty)
+    size_t height() const {
+        size_t result = 0;
+        for (node *n = root; n; n = (n->is_leaf) ? nullptr : as_inner(n)->children[0]) {
+            ++result;
+        }
+
+        return result;
+    }
+
+    // O(1)
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    // O(1)
+    iterator begin() {
+        return iterator(first_leaf, 0);
+    }
+
+    // O(1)
+    const_iterator begin() const {
+        return const_iterator(first_leaf, 0);
+    }
+
+    // O(1)
+    iterator end() {
+        return iterator(last_leaf, (last_leaf) ? last_leaf->count - 1 : 0);
+    }
+
+    // O(1)
+    const_iterator end() const {
+        return const_iterator(last_leaf, (last_leaf) ? last_leaf->count - 1 : 0);
+    }
+};
+
+}
+
+#endif
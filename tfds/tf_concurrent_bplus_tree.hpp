@@ -0,0 +1,606 @@
+#ifndef TF_CONCURRENT_BPLUS_TREE_H
+#define TF_CONCURRENT_BPLUS_TREE_H
+
+#include <atomic> // std::atomic, std::atomic_thread_fence
+#include <thread> // std::this_thread::yield
+#include <cstdint> // uint64_t
+#include "utils/tf_exception.hpp"
+#include "utils/tf_compare_functions.hpp"
+
+namespace tf {
+
+/*
+* Thread-safe ordered map (B+ tree with optimistic lock coupling). Every node has a version that is
+* also its writer lock: readers never write to shared memory, they validate after reading a node that
+* its version has not changed and restart from the root otherwise. Writers lock only the leaf they
+* change and, when a node is split, its parent. Removing entries does not merge nodes, so no node is
+* unlinked while the tree is in use. Keys and values have to be default constructible and fit into
+* lock-free atomics, because readers copy them while other threads may be writing. Keys are unique.
+*/
+template <typename K, typename V>
+class concurrent_bplus_tree {
+private:
+    static_assert(std::atomic<K>::is_always_lock_free && std::atomic<V>::is_always_lock_free,
+        "concurrent b+ tree: keys and values have to fit into lock-free atomics");
+
+    // NODES
+
+    // size of the key/value (leaf) or key/child (inner node) arrays of a node in bytes
+    static const size_t node_bytes = 512;
+
+    static constexpr size_t capacity(const size_t entry_size) {
+        return (node_bytes / entry_size > 4) ? node_bytes / entry_size : 4;
+    }
+
+    // the version is odd while a writer holds the lock of the node, unlocking increments it again
+    struct node {
+        const bool is_leaf;
+        std::atomic<uint64_t> version;
+        std::atomic<size_t> count;
+
+        node(const bool is_leaf):
+            is_leaf(is_leaf), version(0), count(0) {}
+    };
+
+    static const size_t leaf_capacity = capacity(sizeof(K) + sizeof(V));
+    static const size_t inner_capacity = capacity(sizeof(K) + sizeof(node *));
+
+    struct leaf_node : node {
+        std::atomic<K> keys[leaf_capacity];
+        std::atomic<V> values[leaf_capacity];
+
+        leaf_node():
+            node(true) {}
+    };
+
+    // all keys of children[i] are < keys[i] <= all keys of children[i + 1]
+    struct inner_node : node {
+        std::atomic<K> keys[inner_capacity];
+        std::atomic<node *> children[inner_capacity + 1];
+
+        inner_node():
+            node(false) {}
+    };
+
+    static leaf_node *as_leaf(node *n) {
+        return static_cast<leaf_node *>(n);
+    }
+
+    static inner_node *as_inner(node *n) {
+        return static_cast<inner_node *>(n);
+    }
+
+    // node contents are only read and written with relaxed atomics, the versions order them
+    template <typename T>
+    static T load(const std::atomic<T> &field) {
+        return field.load(std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    static void store(std::atomic<T> &field, const T &value) {
+        field.store(value, std::memory_order_relaxed);
+    }
+
+    // a reader can see the count of a node that is being changed, so it is never trusted beyond the capacity
+    static size_t count_of(const node *n, const size_t max_count) {
+        size_t count = load(n->count);
+        return (count < max_count) ? count : max_count;
+    }
+
+    void destroy_subtree(node *n) {
+        if (n->is_leaf) {
+            delete as_leaf(n);
+            return;
+        }
+
+        inner_node *inner = as_inner(n);
+        for (size_t i = 0; i <= load(inner->count); ++i) {
+            destroy_subtree(load(inner->children[i]));
+        }
+
+        delete inner;
+    }
+
+    // OPTIMISTIC LOCK COUPLING
+
+    // false if a writer holds the lock of the node
+    static bool read_lock(const node *n, uint64_t &version) {
+        version = n->version.load(std::memory_order_acquire);
+        return (version & 1) == 0;
+    }
+
+    // true if the node has not changed since read_lock returned the version, so everything read in between is consistent
+    static bool validate(const node *n, const uint64_t version) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return n->version.load(std::memory_order_relaxed) == version;
+    }
+
+    // locks the node if it has not changed since read_lock returned the version
+    static bool upgrade_lock(node *n, uint64_t version) {
+        if (!n->version.compare_exchange_strong(version, version + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            return false;
+
+        // a reader that sees one of the following writes also sees the locked version
+        std::atomic_thread_fence(std::memory_order_release);
+        return true;
+    }
+
+    static void unlock(node *n) {
+        n->version.fetch_add(1, std::memory_order_release);
+    }
+
+    // restart: a writer changed a node that was read, the operation starts again at the root
+    enum attempt { restart, success, failure };
+
+    template <typename F>
+    static attempt retry(F try_operation) {
+        while (true) {
+            attempt result = try_operation();
+            if (result != restart)
+                return result;
+
+            std::this_thread::yield();
+        }
+    }
+
+    // SEARCH
+
+    // number of keys in keys[0, count) that are smaller than key (compare_equal = false)
+    // or smaller than or equal to key (compare_equal = true)
+    static size_t count_smaller(const std::atomic<K> *keys, const size_t count, const K &key, const bool compare_equal) {
+        size_t low = 0;
+        size_t high = count;
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            K middle_key = load(keys[middle]);
+            bool smaller = compare_equal ? !less_than<K>(key, middle_key) : less_than<K>(middle_key, key);
+            if (smaller)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        return low;
+    }
+
+    static size_t child_index(const inner_node *inner, const size_t count, const K &key) {
+        return count_smaller(inner->keys, count, key, true);
+    }
+
+    // reads the root, false if it is locked or has been replaced in the meantime
+    bool read_root(node *&n, uint64_t &version) const {
+        n = root.load(std::memory_order_acquire);
+        return read_lock(n, version) && n == root.load(std::memory_order_acquire);
+    }
+
+    // descends to the leaf whose key range contains the key, false if the operation has to restart.
+    // A child is only visited after its parent has been validated, so it is the right child at that version
+    bool find_leaf(const K &key, leaf_node *&leaf, uint64_t &version) const {
+        node *n;
+        uint64_t n_version;
+        if (!read_root(n, n_version))
+            return false;
+
+        while (!n->is_leaf) {
+            inner_node *inner = as_inner(n);
+            node *child = load(inner->children[child_index(inner, count_of(inner, inner_capacity), key)]);
+
+            uint64_t child_version;
+            if (!validate(inner, n_version) || !read_lock(child, child_version) || !validate(inner, n_version))
+                return false;
+
+            n = child;
+            n_version = child_version;
+        }
+
+        leaf = as_leaf(n);
+        version = n_version;
+        return true;
+    }
+
+    // position of the key in the leaf and whether it is present
+    static size_t leaf_position(const leaf_node *leaf, const size_t count, const K &key, bool &found) {
+        size_t position = count_smaller(leaf->keys, count, key, false);
+        found = (position < count && equals<K>(load(leaf->keys[position]), key));
+        return position;
+    }
+
+    // first (largest = false) or last (largest = true) entry in the subtree, failure if the subtree is empty
+    attempt find_extreme(node *n, const uint64_t version, const bool largest, K &key, V &value) const {
+        if (n->is_leaf) {
+            leaf_node *leaf = as_leaf(n);
+            size_t count = count_of(leaf, leaf_capacity);
+            if (count > 0) {
+                size_t position = largest ? count - 1 : 0;
+                key = load(leaf->keys[position]);
+                value = load(leaf->values[position]);
+            }
+
+            if (!validate(leaf, version))
+                return restart;
+
+            return (count > 0) ? success : failure;
+        }
+
+        // leaves that have become empty are skipped
+        inner_node *inner = as_inner(n);
+        size_t count = count_of(inner, inner_capacity);
+        for (size_t i = 0; i <= count; ++i) {
+            node *child = load(inner->children[largest ? count - i : i]);
+
+            uint64_t child_version;
+            if (!validate(inner, version) || !read_lock(child, child_version) || !validate(inner, version))
+                return restart;
+
+            attempt result = find_extreme(child, child_version, largest, key, value);
+            if (result != failure)
+                return result;
+        }
+
+        return validate(inner, version) ? failure : restart;
+    }
+
+    attempt try_find_extreme(const bool largest, K &key, V &value) const {
+        node *n;
+        uint64_t version;
+        if (!read_root(n, version))
+            return restart;
+
+        return find_extreme(n, version, largest, key, value);
+    }
+
+    // CHANGES (the writer holds the lock of every node it changes)
+
+    static void leaf_insert_at(leaf_node *leaf, const size_t position, const K &key, const V &value) {
+        size_t count = load(leaf->count);
+        for (size_t i = count; i > position; --i) {
+            store(leaf->keys[i], load(leaf->keys[i - 1]));
+            store(leaf->values[i], load(leaf->values[i - 1]));
+        }
+
+        store(leaf->keys[position], key);
+        store(leaf->values[position], value);
+        store(leaf->count, count + 1);
+    }
+
+    static void leaf_remove_at(leaf_node *leaf, const size_t position) {
+        size_t count = load(leaf->count);
+        for (size_t i = position + 1; i < count; ++i) {
+            store(leaf->keys[i - 1], load(leaf->keys[i]));
+            store(leaf->values[i - 1], load(leaf->values[i]));
+        }
+
+        store(leaf->count, count - 1);
+    }
+
+    // the inner node is never full, its child that contains the separator has been split into it and right
+    static void inner_insert(inner_node *inner, const K &separator, node *right) {
+        size_t count = load(inner->count);
+        size_t position = child_index(inner, count, separator);
+        for (size_t i = count; i > position; --i) {
+            store(inner->keys[i], load(inner->keys[i - 1]));
+            store(inner->children[i + 1], load(inner->children[i]));
+        }
+
+        store(inner->keys[position], separator);
+        store(inner->children[position + 1], right);
+        store(inner->count, count + 1);
+    }
+
+    // the right node is not reachable before its separator is inserted into the parent
+    static node *split_leaf(leaf_node *leaf, K &separator) {
+        leaf_node *right = new leaf_node();
+        size_t count = load(leaf->count);
+        size_t middle = count / 2;
+        for (size_t i = middle; i < count; ++i) {
+            store(right->keys[i - middle], load(leaf->keys[i]));
+            store(right->values[i - middle], load(leaf->values[i]));
+        }
+
+        store(right->count, count - middle);
+        store(leaf->count, middle);
+        separator = load(right->keys[0]);
+        return right;
+    }
+
+    static node *split_inner(inner_node *inner, K &separator) {
+        inner_node *right = new inner_node();
+        size_t count = load(inner->count);
+        size_t middle = count / 2;
+        for (size_t i = middle + 1; i < count; ++i) {
+            store(right->keys[i - middle - 1], load(inner->keys[i]));
+        }
+        for (size_t i = middle + 1; i <= count; ++i) {
+            store(right->children[i - middle - 1], load(inner->children[i]));
+        }
+
+        store(right->count, count - middle - 1);
+        store(inner->count, middle);
+        separator = load(inner->keys[middle]);
+        return right;
+    }
+
+    // splits the full node n and inserts the separator into its parent, which is never full because full inner
+    // nodes are split on the way down (both are only changed if their versions are still the ones that were read).
+    // The operation always restarts afterwards
+    void split(inner_node *parent, const uint64_t parent_version, node *n, const uint64_t version) {
+        if (parent && !upgrade_lock(parent, parent_version))
+            return;
+
+        if (!upgrade_lock(n, version)) {
+            if (parent)
+                unlock(parent);
+            return;
+        }
+
+        // only the thread that holds the lock of the root can replace it
+        if (!parent && n != root.load(std::memory_order_relaxed)) {
+            unlock(n);
+            return;
+        }
+
+        K separator;
+        node *right = n->is_leaf ? split_leaf(as_leaf(n), separator) : split_inner(as_inner(n), separator);
+
+        if (parent) {
+            inner_insert(parent, separator, right);
+        }
+        else {
+            inner_node *new_root = new inner_node();
+            store(new_root->keys[0], separator);
+            store(new_root->children[0], n);
+            store(new_root->children[1], right);
+            store(new_root->count, static_cast<size_t>(1));
+            root.store(new_root, std::memory_order_release);
+            height_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        unlock(n);
+        if (parent)
+            unlock(parent);
+    }
+
+    attempt try_insert(const K &key, const V &value) {
+        node *n;
+        uint64_t version;
+        if (!read_root(n, version))
+            return restart;
+
+        inner_node *parent = nullptr;
+        uint64_t parent_version = 0;
+
+        while (!n->is_leaf) {
+            inner_node *inner = as_inner(n);
+            size_t count = count_of(inner, inner_capacity);
+            if (count == inner_capacity) {
+                split(parent, parent_version, inner, version);
+                return restart;
+            }
+
+            node *child = load(inner->children[child_index(inner, count, key)]);
+
+            uint64_t child_version;
+            if (!validate(inner, version) || !read_lock(child, child_version) || !validate(inner, version))
+                return restart;
+
+            parent = inner;
+            parent_version = version;
+            n = child;
+            version = child_version;
+        }
+
+        leaf_node *leaf = as_leaf(n);
+        size_t count = count_of(leaf, leaf_capacity);
+        bool found;
+        size_t position = leaf_position(leaf, count, key, found);
+
+        if (found)
+            return validate(leaf, version) ? failure : restart;
+
+        if (count == leaf_capacity) {
+            split(parent, parent_version, leaf, version);
+            return restart;
+        }
+
+        // the lock is only taken if nothing has changed since the position was computed
+        if (!upgrade_lock(leaf, version))
+            return restart;
+
+        leaf_insert_at(leaf, position, key, value);
+        unlock(leaf);
+        return success;
+    }
+
+    attempt try_get(const K &key, V *value) const {
+        leaf_node *leaf;
+        uint64_t version;
+        if (!find_leaf(key, leaf, version))
+            return restart;
+
+        bool found;
+        size_t position = leaf_position(leaf, count_of(leaf, leaf_capacity), key, found);
+        if (found && value)
+            *value = load(leaf->values[position]);
+
+        if (!validate(leaf, version))
+            return restart;
+
+        return found ? success : failure;
+    }
+
+    attempt try_assign(const K &key, const V &value) {
+        leaf_node *leaf;
+        uint64_t version;
+        if (!find_leaf(key, leaf, version))
+            return restart;
+
+        bool found;
+        size_t position = leaf_position(leaf, count_of(leaf, leaf_capacity), key, found);
+        if (!found)
+            return validate(leaf, version) ? failure : restart;
+
+        if (!upgrade_lock(leaf, version))
+            return restart;
+
+        store(leaf->values[position], value);
+        unlock(leaf);
+        return success;
+    }
+
+    attempt try_remove(const K &key, V &value) {
+        leaf_node *leaf;
+        uint64_t version;
+        if (!find_leaf(key, leaf, version))
+            return restart;
+
+        bool found;
+        size_t position = leaf_position(leaf, count_of(leaf, leaf_capacity), key, found);
+        if (!found)
+            return validate(leaf, version) ? failure : restart;
+
+        if (!upgrade_lock(leaf, version))
+            return restart;
+
+        value = load(leaf->values[position]);
+        leaf_remove_at(leaf, position);
+        unlock(leaf);
+        return success;
+    }
+
+    V remove_entry(const K &key, const char *error) {
+        V value;
+        if (retry([&]() { return try_remove(key, value); }) != success)
+            throw exception(error);
+
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return value;
+    }
+
+    // another thread can remove the extreme entry before this thread does, then the next one is taken
+    V pop_extreme(const bool largest, const char *error) {
+        while (true) {
+            K key;
+            V value;
+            if (retry([&]() { return try_find_extreme(largest, key, value); }) != success)
+                throw exception(error);
+
+            if (retry([&]() { return try_remove(key, value); }) == success) {
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                return value;
+            }
+        }
+    }
+
+    // VARIABLES
+
+    std::atomic<node *> root;
+    std::atomic<size_t> size_;
+    std::atomic<size_t> height_;
+
+public:
+    // CLASS
+
+    // constructor
+    concurrent_bplus_tree():
+        root(new leaf_node()),
+        size_(0),
+        height_(1) {}
+
+    concurrent_bplus_tree(const concurrent_bplus_tree &other) = delete;
+    concurrent_bplus_tree &operator=(const concurrent_bplus_tree &other) = delete;
+
+    // destructor (no other thread may use the tree anymore)
+    ~concurrent_bplus_tree() {
+        destroy_subtree(root.load());
+    }
+
+    // O(log(n))
+    void insert(const K &key, const V &value) {
+        if (retry([&]() { return try_insert(key, value); }) != success)
+            throw exception("concurrent b+ tree: insert: key already exists");
+
+        size_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // O(log(n)), lock-free
+    V get(const K &key) const {
+        V value;
+        if (retry([&]() { return try_get(key, &value); }) != success)
+            throw exception("concurrent b+ tree: get: key not found");
+
+        return value;
+    }
+
+    // O(log(n))
+    void assign(const K &key, const V &value) {
+        if (retry([&]() { return try_assign(key, value); }) != success)
+            throw exception("concurrent b+ tree: assign: key not found");
+    }
+
+    // O(log(n) + number of empty leaves), lock-free: value of the smallest key
+    V min() const {
+        K key;
+        V value;
+        if (retry([&]() { return try_find_extreme(false, key, value); }) != success)
+            throw exception("concurrent b+ tree: min: tree is empty");
+
+        return value;
+    }
+
+    // O(log(n) + number of empty leaves), lock-free: value of the largest key
+    V max() const {
+        K key;
+        V value;
+        if (retry([&]() { return try_find_extreme(true, key, value); }) != success)
+            throw exception("concurrent b+ tree: max: tree is empty");
+
+        return value;
+    }
+
+    // O(log(n) + number of empty leaves)
+    V pop_min() {
+        return pop_extreme(false, "concurrent b+ tree: pop_min: tree is empty");
+    }
+
+    // O(log(n) + number of empty leaves)
+    V pop_max() {
+        return pop_extreme(true, "concurrent b+ tree: pop_max: tree is empty");
+    }
+
+    // O(log(n))
+    V remove(const K &key) {
+        return remove_entry(key, "concurrent b+ tree: remove: key not found");
+    }
+
+    // O(log(n)), lock-free
+    bool contains(const K &key) const {
+        return retry([&]() { return try_get(key, nullptr); }) == success;
+    }
+
+    // O(n) (no other thread may use the tree at the same time)
+    void clear() {
+        destroy_subtree(root.load());
+        root.store(new leaf_node());
+        size_.store(0);
+        height_.store(1);
+    }
+
+    // O(1)
+    size_t size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    // O(1): number of levels
+    size_t height() const {
+        return height_.load(std::memory_order_relaxed);
+    }
+
+    // O(1)
+    bool empty() const {
+        return size() == 0;
+    }
+};
+
+}
+
+#endif
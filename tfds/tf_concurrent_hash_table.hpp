@@ -0,0 +1,361 @@
+#ifndef TF_CONCURRENT_HASH_TABLE_H
+#define TF_CONCURRENT_HASH_TABLE_H
+
+#include <atomic> // std::atomic
+#include <mutex> // std::mutex, std::lock_guard
+#include <cstdint> // uint64_t, uintptr_t
+#include "utils/tf_exception.hpp"
+#include "utils/tf_compare_functions.hpp"
+#include "utils/tf_hash_functions.hpp"
+#include "utils/tf_epoch.hpp"
+
+namespace tf {
+
+/*
+* Thread-safe unordered map (separate chaining hash map with lock-free reads).
+* Writers lock one of a fixed number of mutexes per table, entries are never modified
+* after they are published (assigning a value replaces the entry) and removed entries
+* and tables are freed with epoch based reclamation.
+*/
+template <typename K, typename V, typename Hash = hasher<K>>
+class concurrent_hash_table {
+private:
+    // BUCKET
+
+    struct bucket {
+        const K key;
+        const V value;
+        const uint64_t hash_value;
+        std::atomic<bucket *> next;
+
+        bucket(const K &key, const V &value, const uint64_t hash_value, bucket *next):
+            key(key), value(value), hash_value(hash_value), next(next) {}
+    };
+
+    // marks a chain of the old table that has been copied into the new table during a resize
+    static bucket *moved() {
+        return reinterpret_cast<bucket *>(static_cast<uintptr_t>(1));
+    }
+
+    // TABLE
+
+    struct table {
+        const size_t table_size;
+        const size_t num_locks;
+        std::atomic<bucket *> *buckets;
+        std::mutex *locks;
+
+        // the larger table the chains are moved to during a resize
+        std::atomic<table *> next;
+        std::atomic<size_t> claimed_chains;
+        std::atomic<size_t> migrated_chains;
+
+        table(const size_t table_size):
+            table_size(table_size),
+            num_locks((table_size < max_locks) ? table_size : static_cast<size_t>(max_locks)),
+            buckets(new std::atomic<bucket *>[table_size]),
+            locks(new std::mutex[num_locks]),
+            next(nullptr),
+            claimed_chains(0),
+            migrated_chains(0)
+        {
+            for (size_t i = 0; i < table_size; ++i) {
+                buckets[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        ~table() {
+            delete[] buckets;
+            delete[] locks;
+        }
+
+        size_t index(const uint64_t hash_value) const {
+            return hash_value % table_size;
+        }
+
+        std::mutex &lock_of(const size_t index) {
+            return locks[index % num_locks];
+        }
+    };
+
+    static void destroy_chains(table *t) {
+        for (size_t i = 0; i < t->table_size; ++i) {
+            bucket *b = t->buckets[i].load(std::memory_order_relaxed);
+            if (b == moved())
+                continue;
+
+            while (b) {
+                bucket *next = b->next.load(std::memory_order_relaxed);
+                delete b;
+                b = next;
+            }
+        }
+    }
+
+    static bucket *find_in_chain(bucket *b, const K &key, const uint64_t hash_value) {
+        while (b) {
+            if (b->hash_value == hash_value && equals<K>(key, b->key))
+                return b;
+
+            b = b->next.load(std::memory_order_acquire);
+        }
+
+        return nullptr;
+    }
+
+    // has to be called inside an epoch guard
+    bucket *find_bucket(const K &key, const uint64_t hash_value) const {
+        table *t = current.load(std::memory_order_acquire);
+        while (true) {
+            bucket *head = t->buckets[t->index(hash_value)].load(std::memory_order_acquire);
+            if (head != moved())
+                return find_in_chain(head, key, hash_value);
+
+            t = t->next.load(std::memory_order_acquire);
+        }
+    }
+
+    // locks the chain of the hash in the newest table that has not moved it yet, returns that table
+    table *lock_chain(const uint64_t hash_value, std::unique_lock<std::mutex> &lock) {
+        table *t = current.load(std::memory_order_acquire);
+        while (true) {
+            size_t index = t->index(hash_value);
+            lock = std::unique_lock<std::mutex>(t->lock_of(index));
+
+            if (t->buckets[index].load(std::memory_order_relaxed) != moved())
+                return t;
+
+            lock.unlock();
+            t = t->next.load(std::memory_order_acquire);
+        }
+    }
+
+    // copies one chain of the old table into the new table and marks it as moved
+    void migrate_chain(table *old_table, table *new_table, const size_t index) {
+        std::lock_guard<std::mutex> lock(old_table->lock_of(index));
+
+        bucket *b = old_table->buckets[index].load(std::memory_order_relaxed);
+        bucket *to_retire = b;
+        while (b) {
+            size_t new_index = new_table->index(b->hash_value);
+            std::lock_guard<std::mutex> new_lock(new_table->lock_of(new_index));
+
+            bucket *head = new_table->buckets[new_index].load(std::memory_order_relaxed);
+            new_table->buckets[new_index].store(new bucket(b->key, b->value, b->hash_value, head), std::memory_order_release);
+
+            b = b->next.load(std::memory_order_relaxed);
+        }
+
+        // readers that are still walking the old chain keep it alive until they leave their epoch
+        old_table->buckets[index].store(moved(), std::memory_order_release);
+        while (to_retire) {
+            bucket *next = to_retire->next.load(std::memory_order_relaxed);
+            retire(to_retire);
+            to_retire = next;
+        }
+    }
+
+    // every writer moves a few chains while a resize is in progress
+    void help_migrate() {
+        table *t = current.load(std::memory_order_acquire);
+        table *new_table = t->next.load(std::memory_order_acquire);
+        if (!new_table)
+            return;
+
+        size_t start = t->claimed_chains.fetch_add(migration_steps);
+        if (start >= t->table_size)
+            return;
+
+        size_t end = (start + migration_steps < t->table_size) ? start + migration_steps : t->table_size;
+        for (size_t i = start; i < end; ++i) {
+            migrate_chain(t, new_table, i);
+        }
+
+        // the writer that moves the last chain makes the new table the current table
+        if (t->migrated_chains.fetch_add(end - start) + (end - start) == t->table_size) {
+            current.store(new_table, std::memory_order_release);
+            retire(t);
+        }
+    }
+
+    void start_resize(table *t) {
+        if (t->next.load(std::memory_order_acquire))
+            return;
+
+        table *new_table = new table(t->table_size * 2);
+        table *expected = nullptr;
+        if (!t->next.compare_exchange_strong(expected, new_table))
+            delete new_table;
+    }
+
+    // number of chains that are moved by every insert/remove during a resize
+    static const size_t migration_steps = 16;
+
+    // maximum number of writer locks per table
+    static const size_t max_locks = 4096;
+
+    // VARIABLES
+
+    std::atomic<table *> current;
+    std::atomic<size_t> size_;
+    std::atomic<float> max_load_factor_;
+    Hash hash_function;
+
+public:
+    // CLASS
+
+    // constructor
+    concurrent_hash_table(const size_t table_size = 100):
+        current(new table((table_size > 0) ? table_size : 1)),
+        size_(0),
+        max_load_factor_(1.0f),
+        hash_function() {}
+
+    concurrent_hash_table(const concurrent_hash_table &other) = delete;
+    concurrent_hash_table &operator=(const concurrent_hash_table &other) = delete;
+
+    // destructor (no other thread may use the table anymore)
+    ~concurrent_hash_table() {
+        table *t = current.load();
+        while (t) {
+            table *next = t->next.load();
+            destroy_chains(t);
+            delete t;
+            t = next;
+        }
+    }
+
+    // average: O(1) / worst: O(n)
+    void insert(const K &key, const V &value) {
+        uint64_t hash_value = hash_function(key);
+        epoch_guard guard;
+
+        {
+            std::unique_lock<std::mutex> lock;
+            table *t = lock_chain(hash_value, lock);
+
+            std::atomic<bucket *> &head = t->buckets[t->index(hash_value)];
+            if (find_in_chain(head.load(std::memory_order_relaxed), key, hash_value)) {
+                throw exception("concurrent hash table: insert: key already exists");
+            }
+
+            head.store(new bucket(key, value, hash_value, head.load(std::memory_order_relaxed)), std::memory_order_release);
+        }
+
+        size_t new_size = size_.fetch_add(1, std::memory_order_relaxed) + 1;
+        table *t = current.load(std::memory_order_acquire);
+        if (new_size > t->table_size * max_load_factor_.load(std::memory_order_relaxed))
+            start_resize(t);
+
+        help_migrate();
+    }
+
+    // average: O(1) / worst: O(n), lock-free
+    V get(const K &key) const {
+        uint64_t hash_value = hash_function(key);
+        epoch_guard guard;
+
+        bucket *b = find_bucket(key, hash_value);
+        if (!b)
+            throw exception("concurrent hash table: get: key not found");
+
+        return b->value;
+    }
+
+    // average: O(1) / worst: O(n)
+    void assign(const K &key, const V &value) {
+        uint64_t hash_value = hash_function(key);
+        epoch_guard guard;
+
+        std::unique_lock<std::mutex> lock;
+        table *t = lock_chain(hash_value, lock);
+
+        std::atomic<bucket *> *link = &t->buckets[t->index(hash_value)];
+        bucket *b = link->load(std::memory_order_relaxed);
+        while (b) {
+            if (b->hash_value == hash_value && equals<K>(key, b->key)) {
+                // readers see either the old or the new entry
+                link->store(new bucket(key, value, hash_value, b->next.load(std::memory_order_relaxed)), std::memory_order_release);
+                retire(b);
+                return;
+            }
+
+            link = &b->next;
+            b = link->load(std::memory_order_relaxed);
+        }
+
+        throw exception("concurrent hash table: assign: key not found");
+    }
+
+    // average: O(1) / worst: O(n)
+    V remove(const K &key) {
+        uint64_t hash_value = hash_function(key);
+        epoch_guard guard;
+
+        bucket *b;
+        {
+            std::unique_lock<std::mutex> lock;
+            table *t = lock_chain(hash_value, lock);
+
+            std::atomic<bucket *> *link = &t->buckets[t->index(hash_value)];
+            b = link->load(std::memory_order_relaxed);
+            while (b && !(b->hash_value == hash_value && equals<K>(key, b->key))) {
+                link = &b->next;
+                b = link->load(std::memory_order_relaxed);
+            }
+
+            if (!b)
+                throw exception("concurrent hash table: remove: key not found");
+
+            link->store(b->next.load(std::memory_order_relaxed), std::memory_order_release);
+        }
+
+        // the unlinked entry can only be freed after this thread has left its epoch
+        V result = b->value;
+        retire(b);
+
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        help_migrate();
+        return result;
+    }
+
+    // average: O(1) / worst: O(n), lock-free
+    bool contains(const K &key) const {
+        uint64_t hash_value = hash_function(key);
+        epoch_guard guard;
+
+        return find_bucket(key, hash_value) != nullptr;
+    }
+
+    // O(1): the next insert starts a resize if the new max load factor is exceeded
+    void set_max_load_factor(const float max_load_factor) {
+        if (!(max_load_factor > 0.0f))
+            throw exception("concurrent hash table: set_max_load_factor: max load factor has to be larger than zero");
+
+        max_load_factor_.store(max_load_factor, std::memory_order_relaxed);
+    }
+
+    // O(1)
+    size_t size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    // O(1)
+    size_t table_size() const {
+        return current.load(std::memory_order_acquire)->table_size;
+    }
+
+    // O(1)
+    float max_load_factor() const {
+        return max_load_factor_.load(std::memory_order_relaxed);
+    }
+
+    // O(1)
+    bool empty() const {
+        return size() == 0;
+    }
+};
+
+}
+
+#endif
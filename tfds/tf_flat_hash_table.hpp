@@ -0,0 +1,515 @@
+#ifndef TF_FLAT_HASH_TABLE_H
+#define TF_FLAT_HASH_TABLE_H
+
+#include <new> // ::operator new, placement new
+#include <cstdint> // int8_t, uint32_t, uint64_t
+#include <utility> // std::move
+#include <algorithm> // std::swap, std::fill_n
+#include "utils/tf_exception.hpp"
+#include "utils/tf_compare_functions.hpp"
+#include "utils/tf_hash_functions.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TF_FLAT_HASH_TABLE_SSE2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace tf {
+
+namespace flat_detail {
+
+// control bytes: a full slot stores the low 7 bits of its hash (0..127),
+// empty and deleted slots have the high bit set
+const int8_t ctrl_empty = -128; // 0b10000000
+const int8_t ctrl_deleted = -2; // 0b11111110
+
+inline uint32_t trailing_zeros(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return index;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+/*
+* Bit mask of the matching slots in a group (one bit per slot for SIMD groups,
+* the high bit of every byte for the portable version).
+*/
+template <uint32_t Shift>
+class bit_mask {
+private:
+    uint64_t mask;
+
+public:
+    explicit bit_mask(uint64_t mask): mask(mask) {}
+
+    bool has_value() const { return mask != 0; }
+    uint32_t lowest() const { return trailing_zeros(mask) >> Shift; }
+    void operator++() { mask &= (mask - 1); }
+};
+
+#if defined(__AVX2__)
+
+// 32 control bytes compared at once
+struct group {
+    static const size_t width = 32;
+    __m256i ctrl;
+
+    explicit group(const int8_t *pos):
+        ctrl(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos))) {}
+
+    bit_mask<0> match(const int8_t h2) const {
+        return bit_mask<0>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(h2), ctrl))));
+    }
+
+    bit_mask<0> match_empty() const {
+        return match(ctrl_empty);
+    }
+
+    bit_mask<0> match_empty_or_deleted() const {
+        return bit_mask<0>(static_cast<uint32_t>(_mm256_movemask_epi8(ctrl)));
+    }
+};
+
+#elif defined(TF_FLAT_HASH_TABLE_SSE2)
+
+// 16 control bytes compared at once
+struct group {
+    static const size_t width = 16;
+    __m128i ctrl;
+
+    explicit group(const int8_t *pos):
+        ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+    bit_mask<0> match(const int8_t h2) const {
+        return bit_mask<0>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))));
+    }
+
+    bit_mask<0> match_empty() const {
+        return match(ctrl_empty);
+    }
+
+    bit_mask<0> match_empty_or_deleted() const {
+        return bit_mask<0>(static_cast<uint32_t>(_mm_movemask_epi8(ctrl)));
+    }
+};
+
+#else
+
+// portable fallback: 8 control bytes compared at once inside a 64 bit word
+struct group {
+    static const size_t width = 8;
+    uint64_t ctrl;
+
+    static const uint64_t lsbs = 0x0101010101010101ULL;
+    static const uint64_t msbs = 0x8080808080808080ULL;
+
+    explicit group(const int8_t *pos) {
+        std::memcpy(&ctrl, pos, sizeof(ctrl));
+    }
+
+    // may report false positives, which are filtered by the key comparison
+    bit_mask<3> match(const int8_t h2) const {
+        uint64_t x = ctrl ^ (lsbs * static_cast<uint8_t>(h2));
+        return bit_mask<3>((x - lsbs) & ~x & msbs);
+    }
+
+    bit_mask<3> match_empty() const {
+        return bit_mask<3>((ctrl & (~ctrl << 6)) & msbs);
+    }
+
+    bit_mask<3> match_empty_or_deleted() const {
+        return bit_mask<3>(ctrl & msbs);
+    }
+};
+
+#endif
+
+}
+
+/*
+* Unordered map (open addressing hash map with SIMD probing of control byte groups).
+*/
+template <typename K, typename V, typename Hash = hasher<K>>
+class flat_hash_table {
+private:
+    typedef flat_detail::group group;
+
+    // SLOT
+
+    struct slot {
+        K key;
+        V value;
+
+        slot(const K &key, const V &value):
+            key(key), value(value) {}
+    };
+
+    // spreads the entropy of weak hashes over all bits, since both the group index and the control byte are taken from it
+    static size_t mix(uint64_t hash) {
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 33;
+        return static_cast<size_t>(hash);
+    }
+
+    static size_t h1(const size_t hash) {
+        return hash >> 7;
+    }
+
+    static int8_t h2(const size_t hash) {
+        return static_cast<int8_t>(hash & 0x7F);
+    }
+
+    static size_t max_load(const size_t capacity) {
+        return capacity - capacity / 8;
+    }
+
+    static size_t capacity_for(const size_t num_elements) {
+        size_t capacity = group::width;
+        while (max_load(capacity) < num_elements) {
+            capacity *= 2;
+        }
+
+        return capacity;
+    }
+
+    void allocate(const size_t capacity) {
+        capacity_ = capacity;
+        group_mask = capacity_ / group::width - 1;
+        growth_left = max_load(capacity_);
+        ctrl = new int8_t[capacity_];
+        std::fill_n(ctrl, capacity_, flat_detail::ctrl_empty);
+        slots = static_cast<slot *>(::operator new(capacity_ * sizeof(slot)));
+    }
+
+    void deallocate() {
+        delete[] ctrl;
+        ::operator delete(slots);
+    }
+
+    void set_ctrl(const size_t index, const int8_t value) {
+        ctrl[index] = value;
+    }
+
+    // index of the slot with the given key, or capacity_ if not found
+    size_t find_index(const K &key, const size_t hash) const {
+        size_t g = h1(hash) & group_mask;
+        size_t step = 0;
+        while (true) {
+            group grp(ctrl + g * group::width);
+            for (auto m = grp.match(h2(hash)); m.has_value(); ++m) {
+                size_t index = g * group::width + m.lowest();
+                if (equals<K>(key, slots[index].key)) {
+                    return index;
+                }
+            }
+
+            if (grp.match_empty().has_value()) {
+                return capacity_;
+            }
+
+            g = (g + ++step) & group_mask;
+        }
+    }
+
+    // first empty or deleted slot on the probe sequence of the hash
+    size_t find_free_index(const size_t hash) const {
+        size_t g = h1(hash) & group_mask;
+        size_t step = 0;
+        while (true) {
+            auto m = group(ctrl + g * group::width).match_empty_or_deleted();
+            if (m.has_value()) {
+                return g * group::width + m.lowest();
+            }
+
+            g = (g + ++step) & group_mask;
+        }
+    }
+
+    // O(n)
+    void resize(const size_t new_capacity) {
+        int8_t *old_ctrl = ctrl;
+        slot *old_slots = slots;
+        size_t old_capacity = capacity_;
+
+        allocate(new_capacity);
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] >= 0) {
+                size_t hash = mix(hash_function(old_slots[i].key));
+                size_t index = find_free_index(hash);
+                set_ctrl(index, h2(hash));
+                new (slots + index) slot(std::move(old_slots[i]));
+                old_slots[i].~slot();
+            }
+        }
+
+        growth_left -= size_;
+
+        delete[] old_ctrl;
+        ::operator delete(old_slots);
+    }
+
+    void destroy_all_slots() {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (ctrl[i] >= 0) {
+                slots[i].~slot();
+            }
+        }
+    }
+
+    // VARIABLES
+
+    size_t capacity_;
+    size_t size_;
+    size_t group_mask;
+    size_t growth_left;
+    Hash hash_function;
+    int8_t *ctrl;
+    slot *slots;
+
+public:
+    // ITERATORS
+
+    class iterator {
+    private:
+        flat_hash_table *table;
+        size_t current_index;
+
+        void next_slot() {
+            while (++current_index < table->capacity_ && table->ctrl[current_index] < 0) {}
+        }
+
+    public:
+        iterator(flat_hash_table *table):
+            table(table), current_index(0)
+        {
+            if (table->ctrl[0] < 0)
+                next_slot();
+        }
+
+        const K &key() const { return table->slots[current_index].key; }
+        V &operator*() { return table->slots[current_index].value; }
+        V &value() { return table->slots[current_index].value; }
+        void operator++() { next_slot(); }
+        bool has_value() const { return current_index < table->capacity_; }
+    };
+
+    class const_iterator {
+    private:
+        const flat_hash_table *table;
+        size_t current_index;
+
+        void next_slot() {
+            while (++current_index < table->capacity_ && table->ctrl[current_index] < 0) {}
+        }
+
+    public:
+        const_iterator(const flat_hash_table *table):
+            table(table), current_index(0)
+        {
+            if (table->ctrl[0] < 0)
+                next_slot();
+        }
+
+        const K &key() const { return table->slots[current_index].key; }
+        const V &operator*() const { return table->slots[current_index].value; }
+        const V &value() const { return table->slots[current_index].value; }
+        void operator++() { next_slot(); }
+        bool has_value() const { return current_index < table->capacity_; }
+    };
+
+    // CLASS
+
+    // constructor
+    flat_hash_table(const size_t initial_size = 0):
+        size_(0)
+    {
+        allocate(capacity_for(initial_size));
+    }
+
+    // copy constructor
+    flat_hash_table(const flat_hash_table &other):
+        size_(other.size_),
+        hash_function(other.hash_function)
+    {
+        allocate(other.capacity_);
+        growth_left = other.growth_left;
+        std::copy_n(other.ctrl, capacity_, ctrl);
+
+        size_t i = 0;
+        try {
+            for (; i < capacity_; ++i) {
+                if (ctrl[i] >= 0) {
+                    new (slots + i) slot(other.slots[i]);
+                }
+            }
+        }
+        catch (...) {
+            while (i-- > 0) {
+                if (ctrl[i] >= 0) {
+                    slots[i].~slot();
+                }
+            }
+
+            deallocate();
+            throw;
+        }
+    }
+
+    // destructor
+    ~flat_hash_table() {
+        destroy_all_slots();
+        deallocate();
+    }
+
+    friend void swap(flat_hash_table &first, flat_hash_table &second) noexcept {
+        using std::swap;
+        swap(first.capacity_, second.capacity_);
+        swap(first.size_, second.size_);
+        swap(first.group_mask, second.group_mask);
+        swap(first.growth_left, second.growth_left);
+        swap(first.hash_function, second.hash_function);
+        swap(first.ctrl, second.ctrl);
+        swap(first.slots, second.slots);
+    }
+
+    // move constructor
+    flat_hash_table(flat_hash_table &&other) noexcept : flat_hash_table() {
+        swap(*this, other);
+    }
+
+    // copy assignment operator
+    flat_hash_table &operator=(flat_hash_table other) {
+        swap(*this, other);
+        return *this;
+    }
+
+    // average: O(1) / worst: O(n), O(n) on reallocation
+    void insert(const K &key, const V &value) {
+        size_t hash = mix(hash_function(key));
+        if (find_index(key, hash) != capacity_) {
+            throw exception("flat hash table: insert: key already exists");
+        }
+
+        size_t index = find_free_index(hash);
+        if (growth_left == 0 && ctrl[index] != flat_detail::ctrl_deleted) {
+            // reuse the capacity if it is mostly occupied by deleted slots
+            resize((size_ * 2 < max_load(capacity_)) ? capacity_ : capacity_ * 2);
+            index = find_free_index(hash);
+        }
+
+        new (slots + index) slot(key, value);
+        if (ctrl[index] == flat_detail::ctrl_empty)
+            --growth_left;
+
+        set_ctrl(index, h2(hash));
+        ++size_;
+    }
+
+    // average: O(1) / worst: O(n)
+    const V &get(const K &key) const {
+        size_t index = find_index(key, mix(hash_function(key)));
+        if (index == capacity_)
+            throw exception("flat hash table: get: key not found");
+
+        return slots[index].value;
+    }
+
+    // average: O(1) / worst: O(n)
+    V &operator[](const K &key) {
+        size_t index = find_index(key, mix(hash_function(key)));
+        if (index == capacity_)
+            throw exception("flat hash table: []: key not found");
+
+        return slots[index].value;
+    }
+
+    // average: O(1) / worst: O(n)
+    const V &operator[](const K &key) const {
+        size_t index = find_index(key, mix(hash_function(key)));
+        if (index == capacity_)
+            throw exception("flat hash table: []: key not found");
+
+        return slots[index].value;
+    }
+
+    // average: O(1) / worst: O(n)
+    V remove(const K &key) {
+        size_t index = find_index(key, mix(hash_function(key)));
+        if (index == capacity_)
+            throw exception("flat hash table: remove: key not found");
+
+        V result = std::move(slots[index].value);
+        slots[index].~slot();
+        --size_;
+
+        // a slot can only become empty again if no probe sequence has ever continued past its group
+        size_t g = index / group::width;
+        if (group(ctrl + g * group::width).match_empty().has_value()) {
+            set_ctrl(index, flat_detail::ctrl_empty);
+            ++growth_left;
+        }
+        else {
+            set_ctrl(index, flat_detail::ctrl_deleted);
+        }
+
+        return result;
+    }
+
+    // average: O(1) / worst: O(n)
+    bool contains(const K &key) const {
+        return find_index(key, mix(hash_function(key))) != capacity_;
+    }
+
+    // O(n)
+    void reserve(const size_t num_elements) {
+        size_t new_capacity = capacity_for(num_elements);
+        if (new_capacity > capacity_)
+            resize(new_capacity);
+    }
+
+    // O(capacity)
+    void clear() {
+        destroy_all_slots();
+        std::fill_n(ctrl, capacity_, flat_detail::ctrl_empty);
+        growth_left = max_load(capacity_);
+        size_ = 0;
+    }
+
+    // O(1)
+    size_t size() const {
+        return size_;
+    }
+
+    // O(1)
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    // O(1)
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    iterator begin() {
+        return iterator(this);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this);
+    }
+};
+
+}
+
+#endif
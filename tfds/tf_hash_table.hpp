@@ -1,219 +1,852 @@
 #ifndef TF_HASH_TABLE_H
 #define TF_HASH_TABLE_H
 
+#include <cmath> // std::ceil
+#include <cstdlib> // std::calloc, std::free
+#include <new> // std::bad_alloc
 #include <algorithm> // std::swap
+#include <type_traits> // std::is_trivially_destructible
+#include <utility> // std::forward, std::move
+#include <vector> // std::vector
+#include <iterator> // std::iterator_traits
 #include "utils/tf_exception.hpp"
 #include "utils/tf_compare_functions.hpp"
+#include "utils/tf_hash_functions.hpp"
+#include "utils/tf_pool.hpp"
+#include "utils/tf_prefetch.hpp"
+#include "utils/tf_parallel.hpp"
 
 namespace tf {
 
-// src: http://www.cse.yorku.ca/~oz/hash.html
-// the actual djb2 algorithm which iterates over a string until a '0' is found
-inline unsigned long string_hash(unsigned char *str) {
-    unsigned long hash = 5381;
-    int c;
-
-    while ((c = *str++))
-        hash = ((hash << 5) + hash) + c;
-
-    return hash;
-}
-
-// a modified version that iterates over a fixed number of bytes
-inline unsigned long byte_hash(unsigned char *bytes, int length) {
-    unsigned long hash = 5381;
-    int c;
-
-    int count = 0;
-    while (count++ < length) {
-        c = *bytes++;
-        hash = ((hash << 5) + hash) + c;
-    }
-
-    return hash;
-}
-
-template <typename K>
-inline unsigned long hash(const K &key) {
-    const size_t key_size = sizeof(K);
-    unsigned char bytes[key_size];
-    std::memcpy(bytes, &key, key_size);
-    return byte_hash(bytes, key_size);
-}
-
-template <>
-inline unsigned long hash<std::string>(const std::string &key) {
-    return string_hash((unsigned char *)key.c_str());
-}
-
-template <>
-inline unsigned long hash<const char *>(const char * const &key) {
-    return string_hash((unsigned char *)key);
-}
-
-template <>
-inline unsigned long hash<char *>(char * const &key) {
-    return string_hash((unsigned char *)key);
-}
+/*
+* Statistics of a hash_table (see hash_table::set_track_statistics). Probes are the entries
+* that a lookup compares with its key.
+*/
+struct hash_table_statistics {
+    // chain_lengths[i] is the number of chains with i entries
+    std::vector<size_t> chain_lengths;
+    size_t longest_chain;
+    size_t empty_buckets;
+
+    size_t successful_lookups;
+    size_t failed_lookups;
+    double average_probes_successful;
+    double average_probes_failed;
+
+    size_t rehashes;
+    size_t duplicate_checks;
+    double average_probes_duplicate_check;
+
+    // lookups that checked the Bloom filter, were answered by it (key does not exist) or passed it without finding the key
+    size_t bloom_filter_checks;
+    size_t bloom_filter_rejections;
+    size_t bloom_filter_false_positives;
+    size_t bloom_filter_bytes;
+};
 
 /*
-* Unordered map (separate chaining hash map).
+* Unordered map (separate chaining hash map). Iteration follows the insertion order.
 */
-template <typename K, typename V>
+template <typename K, typename V, typename Hash = hasher<K>>
 class hash_table {
 private:
     // BUCKET 
 
+    // the full hash is stored to skip most key comparisons and to migrate without rehashing the key,
+    // all entries are also linked in insertion order, so that iteration does not visit empty buckets
     struct bucket {
         K key;
         V value;
+        uint64_t hash_value;
         bucket *next;
+        bucket *previous_in_order;
+        bucket *next_in_order;
 
-        bucket(const K &key, const V &value, bucket *next):
-            key(key), value(value), next(next) {}
+        // the value is constructed in place from args
+        template <typename KK, typename... Args>
+        bucket(KK &&key, const uint64_t hash_value, bucket *next, Args &&... args):
+            key(std::forward<KK>(key)), value(std::forward<Args>(args)...), hash_value(hash_value), next(next) {}
     };
 
-    bucket *create_bucket(const K &key, const V &value, bucket *next) {
-        bucket *b = new bucket(key, value, next);
-        ++size_;
+    template <typename KK, typename... Args>
+    bucket *create_bucket(KK &&key, const uint64_t hash_value, bucket *next, Args &&... args) {
+        bucket *b = bucket_pool.create(std::forward<KK>(key), hash_value, next, std::forward<Args>(args)...);
+        append_to_order(b);
+        bloom_filter_add(hash_value);
         return b;
     }
 
     void destroy_bucket(bucket *b) {
+        remove_from_order(b);
+        bucket_pool.destroy(b);
+    }
+
+    // O(1)
+    void append_to_order(bucket *b) {
+        b->previous_in_order = last_in_order;
+        b->next_in_order = nullptr;
+        if (last_in_order)
+            last_in_order->next_in_order = b;
+        else
+            first_in_order = b;
+
+        last_in_order = b;
+        ++size_;
+    }
+
+    // O(1)
+    void remove_from_order(bucket *b) {
+        if (b->previous_in_order)
+            b->previous_in_order->next_in_order = b->next_in_order;
+        else
+            first_in_order = b->next_in_order;
+
+        if (b->next_in_order)
+            b->next_in_order->previous_in_order = b->previous_in_order;
+        else
+            last_in_order = b->previous_in_order;
+
         --size_;
-        delete b;
     }
 
-    void destroy_all_buckets(bucket *b) {
-        while (b) {
-            bucket *to_delete = b;
-            b = b->next;
-            destroy_bucket(to_delete);
+    // the memory of the buckets is released with the pool, only the keys and values have to be destroyed
+    static void destroy_chain_values(bucket *b) {
+        if (!std::is_trivially_destructible<bucket>::value) {
+            while (b) {
+                bucket *next = b->next;
+                b->~bucket();
+                b = next;
+            }
+        }
+    }
+
+    // TABLE
+
+    // calloc gets large tables as fresh pages that the OS zeroes when they are first touched, so the insert
+    // that starts a migration does not write the whole new table (all bits zero is a null pointer here)
+    static bucket **create_table(const size_t table_size) {
+        bucket **table = static_cast<bucket **>(std::calloc(table_size, sizeof(bucket *)));
+        if (!table)
+            throw std::bad_alloc();
+
+        return table;
+    }
+
+    static void destroy_table(bucket **table) {
+        std::free(table);
+    }
+
+    static bool key_equals(const K &key, const K &other) {
+        return equals<K>(key, other);
+    }
+
+    template <typename Q>
+    static bool key_equals(const Q &key, const K &other) {
+        return equals(key, other);
+    }
+
+    // link (chain head or next pointer) that points to the bucket with the key, nullptr if not found
+    template <typename Q>
+    static bucket **find_link_in_chain(const Q &key, const uint64_t hash_value, bucket **link, size_t &probes) {
+        while (*link) {
+            ++probes;
+            if ((*link)->hash_value == hash_value && key_equals(key, (*link)->key)) {
+                return link;
+            }
+
+            link = &(*link)->next;
+        }
+
+        return nullptr;
+    }
+
+    // during a migration, keys can be in the old or in the new table
+    template <typename Q>
+    bucket **find_link(const Q &key, const uint64_t hash_value, size_t &probes) const {
+        if (!bloom_filter_may_contain(hash_value))
+            return nullptr;
+
+        bucket **link = nullptr;
+        if (old_buckets)
+            link = find_link_in_chain(key, hash_value, &old_buckets[hash_value % old_table_size], probes);
+
+        if (!link)
+            link = find_link_in_chain(key, hash_value, &buckets[hash_value % table_size_], probes);
+
+        if (!link && track_statistics && bloom_words)
+            ++counters.bloom_filter_false_positives;
+
+        return link;
+    }
+
+    template <typename Q>
+    bucket **find_link(const Q &key, const uint64_t hash_value) const {
+        size_t probes = 0;
+        bucket **link = find_link(key, hash_value, probes);
+        if (track_statistics)
+            record_lookup(link != nullptr, probes);
+
+        return link;
+    }
+
+    template <typename Q>
+    bucket *find_bucket(const Q &key) const {
+        bucket **link = find_link(key, hash_function(key));
+        return (link) ? *link : nullptr;
+    }
+
+    // enables the lookup overloads for types that are compared and hashed without constructing a K (see is_lookup_key)
+    template <typename Q>
+    using if_lookup_key = typename std::enable_if<is_lookup_key<K, typename std::decay<Q>::type>::value
+        && std::is_invocable_r<uint64_t, const Hash &, const Q &>::value, int>::type;
+
+    // looks up to batch_size keys at once: the chains are walked one step per key in turns and the next
+    // bucket of every key is prefetched, so that the cache misses of different keys overlap
+    void find_batch(const K *keys, const size_t num_keys, bucket **found) const {
+        uint64_t hash_values[batch_size];
+        bucket *current[batch_size];
+        // chain of the current table that is searched after the chain of the old table during a migration
+        bucket *next_chain[batch_size];
+        size_t probes[batch_size];
+        // keys that passed the Bloom filter, the ones that are not found are false positives
+        bool passed_filter[batch_size];
+
+        for (size_t i = 0; i < num_keys; ++i) {
+            hash_values[i] = hash_function(keys[i]);
+            if (old_buckets)
+                prefetch(&old_buckets[hash_values[i] % old_table_size]);
+            prefetch(&buckets[hash_values[i] % table_size_]);
+        }
+
+        size_t remaining = num_keys;
+        for (size_t i = 0; i < num_keys; ++i) {
+            found[i] = nullptr;
+            probes[i] = 0;
+            next_chain[i] = nullptr;
+            passed_filter[i] = bloom_filter_may_contain(hash_values[i]);
+            if (!passed_filter[i]) {
+                current[i] = nullptr;
+                --remaining;
+                continue;
+            }
+
+            current[i] = buckets[hash_values[i] % table_size_];
+
+            if (old_buckets) {
+                bucket *old_chain = old_buckets[hash_values[i] % old_table_size];
+                if (old_chain) {
+                    next_chain[i] = current[i];
+                    current[i] = old_chain;
+                }
+            }
+
+            if (current[i])
+                prefetch(current[i]);
+            else
+                --remaining;
+        }
+
+        while (remaining > 0) {
+            for (size_t i = 0; i < num_keys; ++i) {
+                bucket *b = current[i];
+                if (!b)
+                    continue;
+
+                ++probes[i];
+                if (b->hash_value == hash_values[i] && key_equals(keys[i], b->key)) {
+                    found[i] = b;
+                    b = nullptr;
+                }
+                else {
+                    b = b->next;
+                    if (!b) {
+                        b = next_chain[i];
+                        next_chain[i] = nullptr;
+                    }
+                }
+
+                current[i] = b;
+                if (b)
+                    prefetch(b);
+                else
+                    --remaining;
+            }
+        }
+
+        if (track_statistics) {
+            for (size_t i = 0; i < num_keys; ++i) {
+                record_lookup(found[i] != nullptr, probes[i]);
+                if (!found[i] && passed_filter[i] && bloom_words)
+                    ++counters.bloom_filter_false_positives;
+            }
+        }
+    }
+
+    // adds an entry to the current table (the key has already been hashed and checked), grows the table if necessary
+    template <typename KK, typename... Args>
+    bucket *add_bucket(KK &&key, const uint64_t hash_value, Args &&... args) {
+        uint64_t index = hash_value % table_size_;
+        bucket *b = create_bucket(std::forward<KK>(key), hash_value, buckets[index], std::forward<Args>(args)...);
+        buckets[index] = b;
+
+        grow_if_necessary();
+        return b;
+    }
+
+    // the buckets are only relinked by a migration, so pointers to buckets stay valid
+    void grow_if_necessary() {
+        if (size_ > table_size_ * max_load_factor_) {
+            size_t new_table_size = min_table_size(size_);
+            start_migration((new_table_size > table_size_ * 2) ? new_table_size : table_size_ * 2);
+        }
+    }
+
+    // insert and emplace: one hash and (if duplicate keys are checked or allowed) one chain walk
+    template <typename KK, typename... Args>
+    V &emplace_bucket(KK &&key, Args &&... args) {
+        migrate(migration_steps);
+
+        uint64_t hash_value = hash_function(key);
+        if (check_duplicate_keys || allow_duplicate_keys) {
+            size_t probes = 0;
+            bucket **link = find_link(key, hash_value, probes);
+            if (track_statistics) {
+                ++counters.duplicate_checks;
+                counters.duplicate_check_probes += probes;
+            }
+
+            if (link) {
+                if (!allow_duplicate_keys)
+                    throw exception("hash table: insert: key already exists");
+
+                // entries with equal keys are kept next to each other in their chain, the new entry is
+                // linked in behind the first one (a migration moves a whole chain, so groups stay together)
+                bucket *first = *link;
+                bucket *b = create_bucket(std::forward<KK>(key), hash_value, first->next, std::forward<Args>(args)...);
+                first->next = b;
+
+                grow_if_necessary();
+                return b->value;
+            }
+        }
+
+        return add_bucket(std::forward<KK>(key), hash_value, std::forward<Args>(args)...)->value;
+    }
+
+    // try_emplace and insert_or_assign: one hash and one chain walk, returns the existing bucket or nullptr if inserted
+    template <typename KK, typename... Args>
+    bucket *try_emplace_bucket(KK &&key, Args &&... args) {
+        uint64_t hash_value = hash_function(key);
+        return try_emplace_hashed_bucket(std::forward<KK>(key), hash_value, std::forward<Args>(args)...);
+    }
+
+    // try_emplace_bucket for a key that has already been hashed
+    template <typename KK, typename... Args>
+    bucket *try_emplace_hashed_bucket(KK &&key, const uint64_t hash_value, Args &&... args) {
+        migrate(migration_steps);
+
+        bucket **link = find_link(key, hash_value);
+        if (link)
+            return *link;
+
+        add_bucket(std::forward<KK>(key), hash_value, std::forward<Args>(args)...);
+        return nullptr;
+    }
+
+    // BULK INSERT
+
+    // links the bucket that is constructed in slot into its chain, no other thread may use the chain,
+    // returns false if the key exists and duplicate keys are checked
+    template <typename KK, typename VV>
+    bool link_slot(bucket *slot, KK &&key, VV &&value, const uint64_t hash_value, size_t &duplicate_check_probes) {
+        bucket **chain = &buckets[hash_value % table_size_];
+        if (check_duplicate_keys || allow_duplicate_keys) {
+            bucket **link = find_link_in_chain(key, hash_value, chain, duplicate_check_probes);
+            if (link) {
+                if (!allow_duplicate_keys)
+                    return false;
+
+                chain = &(*link)->next;
+            }
+        }
+
+        *chain = new (slot) bucket(std::forward<KK>(key), hash_value, *chain, std::forward<VV>(value));
+        return true;
+    }
+
+    // the pairs are radix partitioned by bucket range, so that every thread links the entries of its own
+    // range of chains: 1. hash and count per partition, 2. scatter the indices, 3. construct and link
+    template <typename It>
+    void insert_partitioned(It first, const size_t num_pairs, const size_t num_threads) {
+        std::vector<uint64_t> hash_values(num_pairs);
+        // counts[t * num_threads + p]: pairs of the input chunk t in partition p, then the offsets in order
+        std::vector<size_t> counts(num_threads * num_threads, 0);
+        std::vector<size_t> order(num_pairs);
+
+        auto chunk_begin = [num_pairs, num_threads](const size_t t) { return num_pairs / num_threads * t + ((t < num_pairs % num_threads) ? t : num_pairs % num_threads); };
+        auto partition_of = [this, num_threads](const uint64_t hash_value) { return static_cast<size_t>((hash_value % table_size_) * num_threads / table_size_); };
+
+        run_parallel(num_threads, [&](const size_t t) {
+            size_t *chunk_counts = &counts[t * num_threads];
+            for (size_t i = chunk_begin(t); i < chunk_begin(t + 1); ++i) {
+                hash_values[i] = hash_function(first[i].first);
+                ++chunk_counts[partition_of(hash_values[i])];
+            }
+        });
+
+        std::vector<size_t> partition_begin(num_threads + 1, 0);
+        size_t offset = 0;
+        for (size_t p = 0; p < num_threads; ++p) {
+            partition_begin[p] = offset;
+            for (size_t t = 0; t < num_threads; ++t) {
+                size_t count = counts[t * num_threads + p];
+                counts[t * num_threads + p] = offset;
+                offset += count;
+            }
+        }
+        partition_begin[num_threads] = offset;
+
+        run_parallel(num_threads, [&](const size_t t) {
+            size_t *chunk_offsets = &counts[t * num_threads];
+            for (size_t i = chunk_begin(t); i < chunk_begin(t + 1); ++i) {
+                order[chunk_offsets[partition_of(hash_values[i])]++] = i;
+            }
+        });
+
+        // the bucket of order[j] is constructed in slots[j], slots that stay unused are deallocated afterwards
+        bucket *slots = bucket_pool.allocate_contiguous(num_pairs);
+        std::vector<size_t> used(num_threads, 0);
+        std::vector<size_t> probes(num_threads, 0);
+        // slot_of[i]: slot of the pair i, to link the entries in the order of the range afterwards
+        std::vector<size_t> slot_of(num_pairs);
+
+        try {
+            run_parallel(num_threads, [&](const size_t p) {
+                size_t j = partition_begin[p];
+                size_t partition_probes = 0;
+                try {
+                    for (; j < partition_begin[p + 1]; ++j) {
+                        size_t i = order[j];
+                        slot_of[i] = j;
+                        auto &&pair = first[i];
+                        if (!link_slot(slots + j, std::forward<decltype(pair)>(pair).first, std::forward<decltype(pair)>(pair).second, hash_values[i], partition_probes))
+                            throw exception("hash table: insert_many: key already exists");
+                    }
+                }
+                catch (...) {
+                    used[p] = j - partition_begin[p];
+                    probes[p] = partition_probes;
+                    throw;
+                }
+
+                used[p] = j - partition_begin[p];
+                probes[p] = partition_probes;
+            });
+        }
+        catch (...) {
+            finish_partitions(slots, partition_begin, used, probes, order, slot_of);
+            throw;
+        }
+
+        finish_partitions(slots, partition_begin, used, probes, order, slot_of);
+    }
+
+    // appends the linked buckets to the insertion order (in the order of the range) and deallocates the slots that were not used
+    void finish_partitions(bucket *slots, const std::vector<size_t> &partition_begin, const std::vector<size_t> &used, const std::vector<size_t> &probes,
+                           const std::vector<size_t> &order, const std::vector<size_t> &slot_of) {
+        std::vector<size_t> partition_end(partition_begin.size() - 1);
+        for (size_t p = 0; p + 1 < partition_begin.size(); ++p) {
+            partition_end[p] = partition_begin[p] + used[p];
+        }
+
+        for (size_t i = 0; i < order.size(); ++i) {
+            size_t j = slot_of[i];
+            size_t p = static_cast<size_t>(std::upper_bound(partition_begin.begin(), partition_begin.end() - 1, j) - partition_begin.begin()) - 1;
+            if (j < partition_end[p] && order[j] == i) {
+                append_to_order(slots + j);
+                bloom_filter_add(slots[j].hash_value);
+            }
+        }
+
+        for (size_t p = 0; p + 1 < partition_begin.size(); ++p) {
+            for (size_t j = partition_end[p]; j < partition_begin[p + 1]; ++j) {
+                bucket_pool.deallocate(slots + j);
+            }
+
+            if (track_statistics && (check_duplicate_keys || allow_duplicate_keys)) {
+                counters.duplicate_checks += used[p];
+                counters.duplicate_check_probes += probes[p];
+            }
+        }
+    }
+
+    // number of pairs that every thread of insert_many gets at least
+    static const size_t min_pairs_per_thread = 4096;
+
+    // chains of the old table (during a migration) followed by the chains of the current table
+    size_t num_chains() const {
+        return old_table_size + table_size_;
+    }
+
+    bucket *chain_at(const size_t index) const {
+        return (index < old_table_size) ? old_buckets[index] : buckets[index - old_table_size];
+    }
+
+    // moves up to num_chains chains of the old table into the current table
+    void migrate(size_t num_chains) {
+        while (old_buckets && num_chains-- > 0) {
+            bucket *b = old_buckets[migrated_chains];
+            while (b) {
+                bucket *next = b->next;
+                uint64_t index = b->hash_value % table_size_;
+                b->next = buckets[index];
+                buckets[index] = b;
+                bloom_filter_add(b->hash_value);
+                b = next;
+            }
+
+            old_buckets[migrated_chains] = nullptr;
+            if (++migrated_chains == old_table_size) {
+                destroy_table(old_buckets);
+                old_buckets = nullptr;
+                old_table_size = 0;
+                migrated_chains = 0;
+
+                destroy_bloom_words(old_bloom_words);
+                old_bloom_words = nullptr;
+                old_bloom_num_words = 0;
+            }
         }
     }
 
+    void finish_migration() {
+        migrate(old_table_size);
+    }
+
+    // the current table becomes the old table, which is then migrated a few chains per insert/remove
+    // (together with the Bloom filter: the entries are added to a new filter while they are migrated)
+    void start_migration(const size_t new_table_size) {
+        finish_migration();
+
+        if (track_statistics)
+            ++counters.rehashes;
+
+        bucket **new_buckets = create_table(new_table_size);
+        old_buckets = buckets;
+        old_table_size = table_size_;
+        buckets = new_buckets;
+        table_size_ = new_table_size;
+
+        if (bloom_words) {
+            uint64_t *new_bloom_words = create_bloom_words(bloom_filter_num_words());
+            old_bloom_words = bloom_words;
+            old_bloom_num_words = bloom_num_words;
+            bloom_words = new_bloom_words;
+            bloom_num_words = bloom_filter_num_words();
+        }
+    }
+
+    // the next entry with the key of first (entries with equal keys are neighbours), nullptr after the last one
+    static bucket *next_in_group(const bucket *first, const bucket *b) {
+        bucket *next = b->next;
+        if (next && next->hash_value == first->hash_value && key_equals(next->key, first->key))
+            return next;
+
+        return nullptr;
+    }
+
+    size_t min_table_size(const size_t num_entries) const {
+        size_t table_size = static_cast<size_t>(std::ceil(num_entries / max_load_factor_));
+        return (table_size > 0) ? table_size : 1;
+    }
+
+    // BLOOM FILTER
+
+    // blocked Bloom filter with 64 bit blocks: every key sets bloom_mask_bits bits of one word,
+    // so a lookup reads a single word and needs no further hashing
+    static const size_t bloom_mask_bits = 5;
+
+    // the upper half of the hash selects the word, the lower bits the positions in it
+    static uint64_t bloom_mask(const uint64_t hash_value) {
+        uint64_t mask = 0;
+        for (size_t i = 0; i < bloom_mask_bits; ++i) {
+            mask |= 1ULL << ((hash_value >> (6 * i)) & 63);
+        }
+
+        return mask;
+    }
+
+    static size_t bloom_word_index(const uint64_t hash_value, const size_t num_words) {
+        return static_cast<size_t>(((hash_value >> 32) * num_words) >> 32);
+    }
+
+    static bool bloom_words_contain(const uint64_t *words, const size_t num_words, const uint64_t hash_value) {
+        uint64_t mask = bloom_mask(hash_value);
+        return (words[bloom_word_index(hash_value, num_words)] & mask) == mask;
+    }
+
+    // allocated like the tables, so a new filter costs nothing before its words are written
+    static uint64_t *create_bloom_words(const size_t num_words) {
+        uint64_t *words = static_cast<uint64_t *>(std::calloc(num_words, sizeof(uint64_t)));
+        if (!words)
+            throw std::bad_alloc();
+
+        return words;
+    }
+
+    static void destroy_bloom_words(uint64_t *words) {
+        std::free(words);
+    }
+
+    // sized for the entries that fit into the current table before it grows
+    size_t bloom_filter_num_words() const {
+        size_t capacity = static_cast<size_t>(table_size_ * max_load_factor_);
+        capacity = (capacity > size_) ? capacity : size_;
+        size_t num_words = (capacity * bloom_bits_per_entry + 63) / 64;
+        return (num_words > 0) ? num_words : 1;
+    }
+
+    void bloom_filter_add(const uint64_t hash_value) {
+        if (bloom_words)
+            bloom_words[bloom_word_index(hash_value, bloom_num_words)] |= bloom_mask(hash_value);
+    }
+
+    // always true without a filter, during a migration the entries that have not been moved yet are in the old filter
+    bool bloom_filter_may_contain(const uint64_t hash_value) const {
+        if (!bloom_words)
+            return true;
+
+        bool result = bloom_words_contain(bloom_words, bloom_num_words, hash_value)
+            || (old_bloom_words && bloom_words_contain(old_bloom_words, old_bloom_num_words, hash_value));
+
+        if (track_statistics) {
+            ++counters.bloom_filter_checks;
+            counters.bloom_filter_rejections += !result;
+        }
+
+        return result;
+    }
+
+    // O(n): a new filter with all entries (removed keys are dropped from it), no filter if bloom_bits_per_entry is 0
+    void rebuild_bloom_filter() {
+        uint64_t *new_bloom_words = (bloom_bits_per_entry > 0) ? create_bloom_words(bloom_filter_num_words()) : nullptr;
+
+        destroy_bloom_words(bloom_words);
+        destroy_bloom_words(old_bloom_words);
+        bloom_words = new_bloom_words;
+        bloom_num_words = new_bloom_words ? bloom_filter_num_words() : 0;
+        old_bloom_words = nullptr;
+        old_bloom_num_words = 0;
+
+        for (bucket *b = first_in_order; b; b = b->next_in_order) {
+            bloom_filter_add(b->hash_value);
+        }
+    }
+
+    // STATISTICS
+
+    struct statistics_counters {
+        size_t successful_lookups;
+        size_t successful_probes;
+        size_t failed_lookups;
+        size_t failed_probes;
+        size_t rehashes;
+        size_t duplicate_checks;
+        size_t duplicate_check_probes;
+        size_t bloom_filter_checks;
+        size_t bloom_filter_rejections;
+        size_t bloom_filter_false_positives;
+    };
+
+    void record_lookup(const bool found, const size_t probes) const {
+        if (found) {
+            ++counters.successful_lookups;
+            counters.successful_probes += probes;
+        }
+        else {
+            ++counters.failed_lookups;
+            counters.failed_probes += probes;
+        }
+    }
+
+    static double average(const size_t sum, const size_t count) {
+        return (count > 0) ? static_cast<double>(sum) / count : 0.0;
+    }
+
+    // number of old chains that are migrated with every insert/remove
+    static const size_t migration_steps = 8;
+
+    // number of keys that get_many/contains_many look up at the same time
+    static const size_t batch_size = 16;
+
     // VARIABLES
 
     size_t table_size_;
     size_t size_;
     bool check_duplicate_keys;
+    bool allow_duplicate_keys;
+    float max_load_factor_;
+    Hash hash_function;
+    pool<bucket> bucket_pool;
     bucket **buckets;
 
+    // lookups of const functions are counted as well
+    bool track_statistics;
+    mutable statistics_counters counters;
+
+    size_t old_table_size;
+    size_t migrated_chains;
+    bucket **old_buckets;
+
+    bucket *first_in_order;
+    bucket *last_in_order;
+
+    // 0: no Bloom filter (bloom_words is nullptr), the old filter is kept until a migration is finished
+    size_t bloom_bits_per_entry;
+    uint64_t *bloom_words;
+    size_t bloom_num_words;
+    uint64_t *old_bloom_words;
+    size_t old_bloom_num_words;
+
 public:
     // ITERATORS
 
+    // visits the entries in insertion order
     class iterator {
     private:
-        hash_table *table;
-        size_t current_index;
         bucket *current_bucket;
 
-        void next_bucket() {
-            if (current_bucket->next) {
-                current_bucket = current_bucket->next;
-                return;
-            }
-
-            while (++current_index < table->table_size_) {
-                if (table->buckets[current_index]) {
-                    current_bucket = table->buckets[current_index];
-                    return;
-                }
-            }
-
-            current_bucket = nullptr;
-        }
-
     public:
         iterator(hash_table *table):
-            table(table), current_index(0), current_bucket(table->buckets[0])
-        {
-            while (!current_bucket && ++current_index < table->table_size_) {
-                current_bucket = table->buckets[current_index];
-            }
-        }
+            current_bucket(table->first_in_order) {}
 
         const K &key() const { return current_bucket->key; }
         V &operator*() { return current_bucket->value; }
         V &value() { return current_bucket->value; }
-        void operator++() { next_bucket(); }
+        // the hash of the key that the table stored with the entry
+        uint64_t hash_value() const { return current_bucket->hash_value; }
+        void operator++() { current_bucket = current_bucket->next_in_order; }
         bool has_value() const { return current_bucket != nullptr; }
     };
 
+    // visits the entries in insertion order
     class const_iterator {
     private:
-        const hash_table *table;
-        size_t current_index;
         bucket *current_bucket;
 
-        void next_bucket() {
-            if (current_bucket->next) {
-                current_bucket = current_bucket->next;
-                return;
-            }
+    public:
+        const_iterator(const hash_table *table):
+            current_bucket(table->first_in_order) {}
 
-            while (++current_index < table->table_size_) {
-                if (table->buckets[current_index]) {
-                    current_bucket = table->buckets[current_index];
-                    return;
-                }
-            }
+        const K &key() const { return current_bucket->key; }
+        const V &operator*() const { return current_bucket->value; }
+        const V &value() const { return current_bucket->value; }
+        // the hash of the key that the table stored with the entry
+        uint64_t hash_value() const { return current_bucket->hash_value; }
+        void operator++() { current_bucket = current_bucket->next_in_order; }
+        bool has_value() const { return current_bucket != nullptr; }
+    };
 
-            current_bucket = nullptr;
-        }
+    // iterates over the entries with one key (see equal_range), invalidated by inserting or removing that key
+    class key_iterator {
+    private:
+        bucket *first_bucket;
+        bucket *current_bucket;
 
     public:
-        const_iterator(const hash_table *table):
-            table(table), current_index(0), current_bucket(table->buckets[0])
-        {
-            while (!current_bucket && ++current_index < table->table_size_) {
-                current_bucket = table->buckets[current_index];
-            }
-        }
+        key_iterator(bucket *first_bucket):
+            first_bucket(first_bucket), current_bucket(first_bucket) {}
+
+        const K &key() const { return current_bucket->key; }
+        V &operator*() { return current_bucket->value; }
+        V &value() { return current_bucket->value; }
+        void operator++() { current_bucket = next_in_group(first_bucket, current_bucket); }
+        bool has_value() const { return current_bucket != nullptr; }
+    };
+
+    class const_key_iterator {
+    private:
+        bucket *first_bucket;
+        bucket *current_bucket;
+
+    public:
+        const_key_iterator(bucket *first_bucket):
+            first_bucket(first_bucket), current_bucket(first_bucket) {}
 
         const K &key() const { return current_bucket->key; }
         const V &operator*() const { return current_bucket->value; }
         const V &value() const { return current_bucket->value; }
-        void operator++() { next_bucket(); }
+        void operator++() { current_bucket = next_in_group(first_bucket, current_bucket); }
         bool has_value() const { return current_bucket != nullptr; }
     };
 
     // CLASS
 
-    // constructor
-    hash_table(const size_t table_size = 100, const bool check_duplicate_keys = true):
+    // constructor, a table that allows duplicate keys (multimap) never throws on insert and ignores check_duplicate_keys
+    hash_table(const size_t table_size = 100, const bool check_duplicate_keys = true, const bool allow_duplicate_keys = false):
         table_size_((table_size > 0) ? table_size : 1),
         size_(0),
-        check_duplicate_keys(check_duplicate_keys),
-        buckets(new bucket*[table_size_])
-    {
-        for (size_t i = 0; i < table_size_; ++i) {
-            buckets[i] = nullptr;
-        }
-    }
+        check_duplicate_keys(check_duplicate_keys && !allow_duplicate_keys),
+        allow_duplicate_keys(allow_duplicate_keys),
+        max_load_factor_(1.0f),
+        hash_function(),
+        buckets(create_table(table_size_)),
+        track_statistics(false),
+        counters(),
+        old_table_size(0),
+        migrated_chains(0),
+        old_buckets(nullptr),
+        first_in_order(nullptr),
+        last_in_order(nullptr),
+        bloom_bits_per_entry(0),
+        bloom_words(nullptr),
+        bloom_num_words(0),
+        old_bloom_words(nullptr),
+        old_bloom_num_words(0) {}
 
     // copy constructor
     hash_table(const hash_table &other):
         table_size_(other.table_size_),
         size_(0),
         check_duplicate_keys(other.check_duplicate_keys),
-        buckets(new bucket*[table_size_])
+        allow_duplicate_keys(other.allow_duplicate_keys),
+        max_load_factor_(other.max_load_factor_),
+        hash_function(other.hash_function),
+        buckets(create_table(table_size_)),
+        track_statistics(other.track_statistics),
+        counters(),
+        old_table_size(0),
+        migrated_chains(0),
+        old_buckets(nullptr),
+        first_in_order(nullptr),
+        last_in_order(nullptr),
+        bloom_bits_per_entry(other.bloom_bits_per_entry),
+        bloom_words(other.bloom_words ? create_bloom_words(other.bloom_num_words) : nullptr),
+        bloom_num_words(other.bloom_num_words),
+        old_bloom_words(nullptr),
+        old_bloom_num_words(0)
     {
-        for (size_t i = 0; i < table_size_; ++i) {
-            buckets[i] = nullptr;
-
-            bucket *b = other.buckets[i];
-            while (b) {
-                buckets[i] = create_bucket(b->key, b->value, buckets[i]);
-                b = b->next;
+        bucket_pool.reserve(other.size_);
+
+        // in insertion order (including the entries that the other table has not migrated yet)
+        for (bucket *b = other.first_in_order; b; b = b->next_in_order) {
+            bucket **chain = &buckets[b->hash_value % table_size_];
+            if (allow_duplicate_keys) {
+                size_t probes = 0;
+                bucket **link = find_link_in_chain(b->key, b->hash_value, chain, probes);
+                if (link)
+                    chain = &(*link)->next;
             }
+
+            *chain = create_bucket(b->key, b->hash_value, *chain, b->value);
         }
     }
 
     // destructor
     ~hash_table() {
         clear();
-        delete[] buckets;
+        destroy_table(buckets);
+        destroy_bloom_words(bloom_words);
     }
 
     friend void swap(hash_table &first, hash_table &second) noexcept {
@@ -221,7 +854,23 @@ public:
         swap(first.table_size_, second.table_size_);
         swap(first.size_, second.size_);
         swap(first.check_duplicate_keys, second.check_duplicate_keys);
+        swap(first.allow_duplicate_keys, second.allow_duplicate_keys);
+        swap(first.max_load_factor_, second.max_load_factor_);
+        swap(first.hash_function, second.hash_function);
+        swap(first.bucket_pool, second.bucket_pool);
         swap(first.buckets, second.buckets);
+        swap(first.track_statistics, second.track_statistics);
+        swap(first.counters, second.counters);
+        swap(first.old_table_size, second.old_table_size);
+        swap(first.migrated_chains, second.migrated_chains);
+        swap(first.old_buckets, second.old_buckets);
+        swap(first.first_in_order, second.first_in_order);
+        swap(first.last_in_order, second.last_in_order);
+        swap(first.bloom_bits_per_entry, second.bloom_bits_per_entry);
+        swap(first.bloom_words, second.bloom_words);
+        swap(first.bloom_num_words, second.bloom_num_words);
+        swap(first.old_bloom_words, second.old_bloom_words);
+        swap(first.old_bloom_num_words, second.old_bloom_num_words);
     }
 
     // move constructor
@@ -237,133 +886,413 @@ public:
 
     // average: O(1) / worst: O(n)
     void insert(const K &key, const V &value) {
-        unsigned long index = hash<K>(key) % table_size_;
-
-        if (buckets[index]) {
-            if (check_duplicate_keys) {
-                bucket *it = buckets[index];
-                while (it) {
-                    if (equals<K>(key, it->key)) {
-                        throw exception("hash table: insert: key already exists");
-                    }
+        emplace_bucket(key, value);
+    }
 
-                    it = it->next;
-                }
-            }
+    // average: O(1) / worst: O(n)
+    void insert(const K &key, V &&value) {
+        emplace_bucket(key, std::move(value));
+    }
 
-            buckets[index] = create_bucket(key, value, buckets[index]);
-        }
-        else {
-            buckets[index] = create_bucket(key, value, nullptr);
-        }
+    // average: O(1) / worst: O(n)
+    void insert(K &&key, V &&value) {
+        emplace_bucket(std::move(key), std::move(value));
+    }
+
+    // average: O(1) / worst: O(n), constructs the value in place from args and returns it
+    template <typename... Args>
+    V &emplace(const K &key, Args &&... args) {
+        return emplace_bucket(key, std::forward<Args>(args)...);
+    }
+
+    // average: O(1) / worst: O(n), constructs the value in place from args and returns it
+    template <typename... Args>
+    V &emplace(K &&key, Args &&... args) {
+        return emplace_bucket(std::move(key), std::forward<Args>(args)...);
+    }
+
+    // average: O(1) / worst: O(n), does nothing (args are not used) if the key exists, returns true if inserted
+    template <typename... Args>
+    bool try_emplace(const K &key, Args &&... args) {
+        return try_emplace_bucket(key, std::forward<Args>(args)...) == nullptr;
+    }
+
+    // average: O(1) / worst: O(n), does nothing (args are not used) if the key exists, returns true if inserted
+    template <typename... Args>
+    bool try_emplace(K &&key, Args &&... args) {
+        return try_emplace_bucket(std::move(key), std::forward<Args>(args)...) == nullptr;
+    }
+
+    // average: O(1) / worst: O(n), assigns the value if the key exists, returns true if inserted
+    template <typename VV>
+    bool insert_or_assign(const K &key, VV &&value) {
+        bucket *b = try_emplace_bucket(key, std::forward<VV>(value));
+        if (b)
+            b->value = std::forward<VV>(value);
+
+        return b == nullptr;
+    }
+
+    // average: O(1) / worst: O(n), assigns the value if the key exists, returns true if inserted
+    template <typename VV>
+    bool insert_or_assign(K &&key, VV &&value) {
+        bucket *b = try_emplace_bucket(std::move(key), std::forward<VV>(value));
+        if (b)
+            b->value = std::forward<VV>(value);
+
+        return b == nullptr;
+    }
+
+    // average: O(1) / worst: O(n), if the key exists, the value becomes combine(old value, value), returns true if inserted
+    template <typename VV, typename Combine>
+    bool insert_or_combine(const K &key, VV &&value, Combine &&combine) {
+        bucket *b = try_emplace_bucket(key, std::forward<VV>(value));
+        if (b)
+            b->value = combine(std::move(b->value), std::forward<VV>(value));
+
+        return b == nullptr;
+    }
+
+    // average: O(1) / worst: O(n), if the key exists, the value becomes combine(old value, value), returns true if inserted
+    template <typename VV, typename Combine>
+    bool insert_or_combine(K &&key, VV &&value, Combine &&combine) {
+        bucket *b = try_emplace_bucket(std::move(key), std::forward<VV>(value));
+        if (b)
+            b->value = combine(std::move(b->value), std::forward<VV>(value));
+
+        return b == nullptr;
+    }
+
+    // average: O(1) / worst: O(n), insert_or_combine without hashing the key: hash_value has to be the hash that Hash
+    // computes for the key (for example it.hash_value() of a table with the same Hash)
+    template <typename VV, typename Combine>
+    bool insert_or_combine_hashed(const K &key, const uint64_t hash_value, VV &&value, Combine &&combine) {
+        bucket *b = try_emplace_hashed_bucket(key, hash_value, std::forward<VV>(value));
+        if (b)
+            b->value = combine(std::move(b->value), std::forward<VV>(value));
+
+        return b == nullptr;
+    }
+
+    // average: O(1) / worst: O(n), insert_or_combine without hashing the key: hash_value has to be the hash that Hash
+    // computes for the key (for example it.hash_value() of a table with the same Hash)
+    template <typename VV, typename Combine>
+    bool insert_or_combine_hashed(K &&key, const uint64_t hash_value, VV &&value, Combine &&combine) {
+        bucket *b = try_emplace_hashed_bucket(std::move(key), hash_value, std::forward<VV>(value));
+        if (b)
+            b->value = combine(std::move(b->value), std::forward<VV>(value));
+
+        return b == nullptr;
+    }
+
+    // average: O(number of pairs / number of threads) / worst: O(number of pairs * n)
+    // inserts the pairs (.first: key, .second: value) of [first, last) on num_threads threads (0: one per core),
+    // the pairs are copied (moved with std::make_move_iterator). If an exception is thrown (for example because
+    // a key already exists), the table contains an unspecified part of the pairs
+    template <typename It>
+    void insert_many(It first, It last, const size_t num_threads = 0) {
+        static_assert(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value,
+            "hash table: insert_many: random access iterators required");
+
+        size_t num_pairs = static_cast<size_t>(last - first);
+        if (num_pairs == 0)
+            return;
+
+        // the table is grown once up front, the chains are not relinked while the threads link into them
+        finish_migration();
+        reserve(size_ + num_pairs);
+
+        insert_partitioned(first, num_pairs, num_threads_for(num_pairs, num_threads, min_pairs_per_thread));
     }
 
     // average: O(1) / worst: O(n)
     const V &get(const K &key) const {
-        unsigned long index = hash<K>(key) % table_size_;
+        bucket *b = find_bucket(key);
+        if (!b)
+            throw exception("hash table: get: key not found");
 
-        bucket *it = buckets[index];
-        while (it) {
-            if (equals<K>(key, it->key)) {
-                return it->value;
-            }
+        return b->value;
+    }
 
-            it = it->next;
-        }
+    // average: O(1) / worst: O(n)
+    V &operator[](const K &key) {
+        bucket *b = find_bucket(key);
+        if (!b)
+            throw exception("hash table: []: key not found");
 
-        throw exception("hash table: get: key not found");
+        return b->value;
     }
 
     // average: O(1) / worst: O(n)
-    V &operator[](const K &key) {
-        unsigned long index = hash<K>(key) % table_size_;
+    const V &operator[](const K &key) const {
+        bucket *b = find_bucket(key);
+        if (!b)
+            throw exception("hash table: []: key not found");
 
-        bucket *it = buckets[index];
-        while (it) {
-            if (equals<K>(key, it->key)) {
-                return it->value;
-            }
+        return b->value;
+    }
 
-            it = it->next;
-        }
+    // average: O(1) / worst: O(n)
+    V remove(const K &key) {
+        migrate(migration_steps);
+
+        bucket **link = find_link(key, hash_function(key));
+        if (!link)
+            throw exception("hash table: remove: key not found");
+
+        bucket *to_delete = *link;
+        *link = to_delete->next;
 
-        throw exception("hash table: []: key not found");
+        V result = std::move(to_delete->value);
+        destroy_bucket(to_delete);
+        return result;
     }
 
     // average: O(1) / worst: O(n)
-    const V &operator[](const K &key) const {
-        unsigned long index = hash<K>(key) % table_size_;
+    bool contains(const K &key) const {
+        return find_bucket(key) != nullptr;
+    }
 
-        bucket *it = buckets[index];
-        while (it) {
-            if (equals<K>(key, it->key)) {
-                return it->value;
-            }
+    // average: O(1 + #values with that key) / worst: O(n), the iterator has no value if the key does not exist
+    key_iterator equal_range(const K &key) {
+        return key_iterator(find_bucket(key));
+    }
+
+    // average: O(1 + #values with that key) / worst: O(n), the iterator has no value if the key does not exist
+    const_key_iterator equal_range(const K &key) const {
+        return const_key_iterator(find_bucket(key));
+    }
 
-            it = it->next;
+    // average: O(1 + #values with that key) / worst: O(n)
+    size_t count(const K &key) const {
+        bucket *first = find_bucket(key);
+        size_t result = 0;
+        for (bucket *b = first; b; b = next_in_group(first, b)) {
+            ++result;
         }
 
-        throw exception("hash table: []: key not found");
+        return result;
     }
 
-    // average: O(1) / worst: O(n)
-    V remove(const K &key) {
-        unsigned long index = hash<K>(key) % table_size_;
+    // average: O(1 + #values with that key) / worst: O(n), returns the number of removed entries
+    size_t remove_all(const K &key) {
+        migrate(migration_steps);
 
-        if (buckets[index]) {
-            bucket *to_delete = nullptr;
+        uint64_t hash_value = hash_function(key);
+        bucket **link = find_link(key, hash_value);
+        if (!link)
+            throw exception("hash table: remove_all: key not found");
 
-            if (equals<K>(key, buckets[index]->key)) {
-                to_delete = buckets[index];
-                buckets[index] = to_delete->next;
-            }
-            else {
-                bucket *it = buckets[index]->next;
-                bucket *prev = buckets[index];
-                while (it) {
-                    if (equals<K>(key, it->key)) {
-                        to_delete = it;
-                        prev->next = it->next;
-                        break;
-                    }
+        size_t result = 0;
+        while (*link && (*link)->hash_value == hash_value && key_equals(key, (*link)->key)) {
+            bucket *to_delete = *link;
+            *link = to_delete->next;
+            destroy_bucket(to_delete);
+            ++result;
+        }
 
-                    prev = it;
-                    it = it->next;
-                }
-            }
+        return result;
+    }
+
+    // average: O(1) / worst: O(n), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    const V &get(const Q &key) const {
+        bucket *b = find_bucket(key);
+        if (!b)
+            throw exception("hash table: get: key not found");
+
+        return b->value;
+    }
+
+    // average: O(1) / worst: O(n), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    V &operator[](const Q &key) {
+        bucket *b = find_bucket(key);
+        if (!b)
+            throw exception("hash table: []: key not found");
+
+        return b->value;
+    }
+
+    // average: O(1) / worst: O(n), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    const V &operator[](const Q &key) const {
+        bucket *b = find_bucket(key);
+        if (!b)
+            throw exception("hash table: []: key not found");
+
+        return b->value;
+    }
+
+    // average: O(1) / worst: O(n), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    V remove(const Q &key) {
+        migrate(migration_steps);
+
+        bucket **link = find_link(key, hash_function(key));
+        if (!link)
+            throw exception("hash table: remove: key not found");
 
-            if (to_delete) {
-                V result = to_delete->value;
-                destroy_bucket(to_delete);
-                return result;
+        bucket *to_delete = *link;
+        *link = to_delete->next;
+
+        V result = std::move(to_delete->value);
+        destroy_bucket(to_delete);
+        return result;
+    }
+
+    // average: O(1) / worst: O(n), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    bool contains(const Q &key) const {
+        return find_bucket(key) != nullptr;
+    }
+
+    // average: O(num_keys) / worst: O(num_keys * n)
+    // values[i] points to the value of keys[i] (nullptr if the key does not exist), returns the number of found keys
+    size_t get_many(const K *keys, const size_t num_keys, const V **values) const {
+        bucket *found[batch_size];
+        size_t num_found = 0;
+
+        for (size_t start = 0; start < num_keys; start += batch_size) {
+            size_t n = (num_keys - start < batch_size) ? num_keys - start : batch_size;
+            find_batch(keys + start, n, found);
+
+            for (size_t i = 0; i < n; ++i) {
+                values[start + i] = (found[i]) ? &found[i]->value : nullptr;
+                num_found += (found[i] != nullptr);
             }
         }
 
-        throw exception("hash table: remove: key not found");
+        return num_found;
     }
 
-    // average: O(1) / worst: O(n)
-    bool contains(const K &key) const {
-        unsigned long index = hash<K>(key) % table_size_;
+    // average: O(num_keys) / worst: O(num_keys * n)
+    // results[i] is true if keys[i] exists, returns the number of found keys
+    size_t contains_many(const K *keys, const size_t num_keys, bool *results) const {
+        bucket *found[batch_size];
+        size_t num_found = 0;
 
-        bucket *it = buckets[index];
-        while (it) {
-            if (equals<K>(key, it->key)) {
-                return true;
-            }
+        for (size_t start = 0; start < num_keys; start += batch_size) {
+            size_t n = (num_keys - start < batch_size) ? num_keys - start : batch_size;
+            find_batch(keys + start, n, found);
 
-            it = it->next;
+            for (size_t i = 0; i < n; ++i) {
+                results[start + i] = (found[i] != nullptr);
+                num_found += (found[i] != nullptr);
+            }
         }
 
-        return false;
+        return num_found;
     }
 
     // O(n)
+    void rehash(const size_t table_size) {
+        size_t min_size = min_table_size(size_);
+        start_migration((table_size > min_size) ? table_size : min_size);
+        finish_migration();
+    }
+
+    // O(n)
+    void reserve(const size_t num_entries) {
+        size_t table_size = min_table_size(num_entries);
+        if (table_size > table_size_)
+            rehash(table_size);
+    }
+
+    // O(n)
+    void shrink_to_fit() {
+        rehash(min_table_size(size_));
+    }
+
+    // O(1): the Bloom filter keeps the size it has for the old max load factor until the table grows
+    // (call set_bloom_filter again to resize it at once)
+    void set_max_load_factor(const float max_load_factor) {
+        if (!(max_load_factor > 0.0f))
+            throw exception("hash table: set_max_load_factor: max load factor has to be larger than zero");
+
+        max_load_factor_ = max_load_factor;
+    }
+
+    // O(table size) / O(n) if the keys or values have destructors
     void clear() {
         for (size_t i = 0; i < table_size_; ++i) {
-            destroy_all_buckets(buckets[i]);
+            destroy_chain_values(buckets[i]);
             buckets[i] = nullptr;
         }
+
+        for (size_t i = 0; i < old_table_size; ++i) {
+            destroy_chain_values(old_buckets[i]);
+        }
+
+        destroy_table(old_buckets);
+        old_buckets = nullptr;
+        old_table_size = 0;
+        migrated_chains = 0;
+
+        bucket_pool.release();
+        first_in_order = nullptr;
+        last_in_order = nullptr;
+        size_ = 0;
+
+        if (bloom_words)
+            std::fill(bloom_words, bloom_words + bloom_num_words, 0);
+
+        destroy_bloom_words(old_bloom_words);
+        old_bloom_words = nullptr;
+        old_bloom_num_words = 0;
+    }
+
+    // O(n): bits_per_entry > 0 turns on a Bloom filter that answers most lookups of missing keys without
+    // walking a chain (12 bits: about 1% false positives), 0 turns it off. The filter is rebuilt incrementally while the table grows
+    void set_bloom_filter(const size_t bits_per_entry) {
+        bloom_bits_per_entry = bits_per_entry;
+        rebuild_bloom_filter();
+    }
+
+    // O(1): lookups, duplicate checks and rehashes are only counted while tracking is turned on
+    void set_track_statistics(const bool track) {
+        track_statistics = track;
+    }
+
+    // O(1)
+    void reset_statistics() {
+        counters = statistics_counters();
+    }
+
+    // O(table size)
+    hash_table_statistics statistics() const {
+        hash_table_statistics result;
+        result.longest_chain = 0;
+
+        for (size_t i = 0; i < num_chains(); ++i) {
+            size_t length = 0;
+            for (bucket *b = chain_at(i); b; b = b->next) {
+                ++length;
+            }
+
+            if (length >= result.chain_lengths.size())
+                result.chain_lengths.resize(length + 1, 0);
+
+            ++result.chain_lengths[length];
+            result.longest_chain = (length > result.longest_chain) ? length : result.longest_chain;
+        }
+
+        // the chains of the old table that have already been migrated are not buckets anymore
+        result.chain_lengths[0] -= migrated_chains;
+        result.empty_buckets = result.chain_lengths[0];
+
+        result.successful_lookups = counters.successful_lookups;
+        result.failed_lookups = counters.failed_lookups;
+        result.average_probes_successful = average(counters.successful_probes, counters.successful_lookups);
+        result.average_probes_failed = average(counters.failed_probes, counters.failed_lookups);
+        result.rehashes = counters.rehashes;
+        result.duplicate_checks = counters.duplicate_checks;
+        result.average_probes_duplicate_check = average(counters.duplicate_check_probes, counters.duplicate_checks);
+        result.bloom_filter_checks = counters.bloom_filter_checks;
+        result.bloom_filter_rejections = counters.bloom_filter_rejections;
+        result.bloom_filter_false_positives = counters.bloom_filter_false_positives;
+        result.bloom_filter_bytes = (bloom_num_words + old_bloom_num_words) * sizeof(uint64_t);
+        return result;
     }
 
     // O(1)
@@ -376,11 +1305,41 @@ public:
         return table_size_;
     }
 
+    // O(1)
+    float load_factor() const {
+        return static_cast<float>(size_) / table_size_;
+    }
+
+    // O(1)
+    float max_load_factor() const {
+        return max_load_factor_;
+    }
+
+    // O(1)
+    bool rehashing() const {
+        return old_buckets != nullptr;
+    }
+
+    // O(1)
+    bool tracks_statistics() const {
+        return track_statistics;
+    }
+
+    // O(1): 0 if there is no Bloom filter
+    size_t bloom_filter_bits_per_entry() const {
+        return bloom_bits_per_entry;
+    }
+
     // O(1)
     bool checks_duplicate_keys() const {
         return check_duplicate_keys;
     }
 
+    // O(1)
+    bool allows_duplicate_keys() const {
+        return allow_duplicate_keys;
+    }
+
     // O(1)
     bool empty() const {
         return size_ == 0;
@@ -397,4 +1356,4 @@ public:
 
 }
 
-#endif
\ No newline at end of file
+#endif
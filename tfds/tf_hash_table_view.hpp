@@ -0,0 +1,420 @@
+#ifndef TF_HASH_TABLE_VIEW_H
+#define TF_HASH_TABLE_VIEW_H
+
+#include <string> // std::string
+#include <string_view> // std::string_view
+#include <vector> // std::vector
+#include <fstream> // std::ofstream, std::ifstream
+#include <algorithm> // std::swap
+#include <type_traits> // std::is_trivially_copyable
+#include <cstring> // std::memcpy, std::memcmp
+#include <cstdint> // uint64_t
+#include "tf_hash_table.hpp"
+#include "utils/tf_exception.hpp"
+#include "utils/tf_compare_functions.hpp"
+#include "utils/tf_hash_functions.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h> // open
+#include <unistd.h> // close
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#endif
+
+namespace tf {
+
+namespace snapshot_detail {
+
+const char magic[8] = { 't', 'f', 'd', 's', 's', 'n', 'a', 'p' };
+
+// written in the byte order of the machine that wrote the snapshot
+const uint64_t byte_order = 0x0102030405060708ULL;
+
+// the sections of the image start at multiples of this
+const uint64_t section_alignment = 64;
+
+/*
+* The image consists of the header, table_size + 1 chain offsets (the entries of chain i are the
+* entries chains[i] to chains[i + 1] - 1), the entries and the bytes of string keys.
+* All positions are offsets from the start of the image, so it can be mapped at any address.
+*/
+struct header {
+    char magic[8];
+    uint64_t byte_order;
+    uint64_t key_size;
+    uint64_t value_size;
+    uint64_t entry_size;
+    uint64_t num_entries;
+    uint64_t table_size;
+    uint64_t chains_offset;
+    uint64_t entries_offset;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+};
+
+// keys that are trivially copyable are stored as they are. Pointers would be stored as addresses that
+// are meaningless in another process or after the image is mapped again, so they are rejected
+template <typename K>
+struct key_format {
+    static_assert(std::is_trivially_copyable<K>::value, "hash table view: keys have to be trivially copyable or std::string");
+    static_assert(!std::is_pointer<K>::value, "hash table view: keys cannot be pointers, the snapshot would store addresses");
+
+    typedef K stored_key;
+    typedef K lookup_key;
+
+    static stored_key store(const K &key, std::string &) {
+        return key;
+    }
+
+    static bool equals(const lookup_key &key, const stored_key &stored, const char *, const uint64_t) {
+        return tf::equals<K>(key, stored);
+    }
+};
+
+// std::string keys are stored as position and length of their characters in the strings section
+template <>
+struct key_format<std::string> {
+    struct stored_key {
+        uint64_t offset;
+        uint64_t length;
+    };
+
+    typedef std::string_view lookup_key;
+
+    static stored_key store(const std::string &key, std::string &strings) {
+        stored_key stored = { strings.size(), key.size() };
+        strings += key;
+        return stored;
+    }
+
+    static bool equals(const lookup_key &key, const stored_key &stored, const char *strings, const uint64_t strings_size) {
+        return key.size() == stored.length && stored.length <= strings_size && stored.offset <= strings_size - stored.length
+            && std::memcmp(key.data(), strings + stored.offset, key.size()) == 0;
+    }
+};
+
+template <typename K, typename V>
+struct entry {
+    uint64_t hash_value;
+    typename key_format<K>::stored_key key;
+    V value;
+};
+
+// zeroed memory for one entry, so that the padding bytes of the image are always the same
+template <typename K, typename V>
+union entry_storage {
+    entry<K, V> e;
+    unsigned char bytes[sizeof(entry<K, V>)];
+
+    entry_storage(): bytes() {}
+};
+
+inline uint64_t align(const uint64_t offset) {
+    return (offset + section_alignment - 1) / section_alignment * section_alignment;
+}
+
+inline void write_padding(std::ofstream &file, const uint64_t from, const uint64_t to) {
+    static const char zeros[section_alignment] = {};
+    file.write(zeros, static_cast<std::streamsize>(to - from));
+}
+
+}
+
+/*
+* Writes the entries of the table into a file that can be opened with a hash_table_view.
+* Keys have to be trivially copyable or std::string, values have to be trivially copyable.
+* Neither can be pointers (or contain pointers), because the image has to be position-independent.
+* O(n)
+*/
+template <typename K, typename V, typename Hash>
+void write_snapshot(const hash_table<K, V, Hash> &table, const std::string &path) {
+    static_assert(std::is_trivially_copyable<V>::value, "hash table view: values have to be trivially copyable");
+    static_assert(!std::is_pointer<V>::value, "hash table view: values cannot be pointers, the snapshot would store addresses");
+
+    typedef snapshot_detail::key_format<K> key_format;
+    typedef snapshot_detail::entry<K, V> entry;
+    static_assert(alignof(entry) <= snapshot_detail::section_alignment, "hash table view: values with an alignment above 64 are not supported");
+
+    uint64_t num_entries = table.size();
+    uint64_t table_size = (num_entries > 0) ? num_entries : 1;
+
+    // counting sort of the entries by chain, the keys are not hashed again: the snapshot gets the hashes of the table
+    std::vector<uint64_t> hash_values;
+    std::vector<uint64_t> chains(table_size + 1, 0);
+    hash_values.reserve(num_entries);
+    for (auto it = table.begin(); it.has_value(); ++it) {
+        hash_values.push_back(it.hash_value());
+        ++chains[hash_values.back() % table_size + 1];
+    }
+
+    for (uint64_t i = 0; i < table_size; ++i) {
+        chains[i + 1] += chains[i];
+    }
+
+    std::vector<uint64_t> positions(chains.begin(), chains.end() - 1);
+    std::vector<unsigned char> entries(num_entries * sizeof(entry));
+    std::string strings;
+
+    size_t i = 0;
+    for (auto it = table.begin(); it.has_value(); ++it, ++i) {
+        snapshot_detail::entry_storage<K, V> storage;
+        typename key_format::stored_key stored = key_format::store(it.key(), strings);
+
+        std::memcpy(&storage.e.hash_value, &hash_values[i], sizeof(uint64_t));
+        std::memcpy(&storage.e.key, &stored, sizeof(stored));
+        std::memcpy(&storage.e.value, &it.value(), sizeof(V));
+        std::memcpy(&entries[positions[hash_values[i] % table_size]++ * sizeof(entry)], storage.bytes, sizeof(entry));
+    }
+
+    snapshot_detail::header h;
+    std::memcpy(h.magic, snapshot_detail::magic, sizeof(h.magic));
+    h.byte_order = snapshot_detail::byte_order;
+    h.key_size = sizeof(typename key_format::stored_key);
+    h.value_size = sizeof(V);
+    h.entry_size = sizeof(entry);
+    h.num_entries = num_entries;
+    h.table_size = table_size;
+    h.chains_offset = snapshot_detail::align(sizeof(h));
+    h.entries_offset = snapshot_detail::align(h.chains_offset + chains.size() * sizeof(uint64_t));
+    h.strings_offset = snapshot_detail::align(h.entries_offset + entries.size());
+    h.strings_size = strings.size();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw exception("hash table view: write_snapshot: cannot open " + path);
+
+    file.write(reinterpret_cast<const char *>(&h), sizeof(h));
+    snapshot_detail::write_padding(file, sizeof(h), h.chains_offset);
+    file.write(reinterpret_cast<const char *>(chains.data()), static_cast<std::streamsize>(chains.size() * sizeof(uint64_t)));
+    snapshot_detail::write_padding(file, h.chains_offset + chains.size() * sizeof(uint64_t), h.entries_offset);
+    file.write(reinterpret_cast<const char *>(entries.data()), static_cast<std::streamsize>(entries.size()));
+    snapshot_detail::write_padding(file, h.entries_offset + entries.size(), h.strings_offset);
+    file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+    if (!file.flush())
+        throw exception("hash table view: write_snapshot: cannot write " + path);
+}
+
+/*
+* Read-only unordered map on a snapshot written by write_snapshot. The file is memory mapped
+* (read into memory on Windows), lookups read the entries directly from the image.
+* Hash has to produce the same hashes as the hash function of the written table.
+*/
+template <typename K, typename V, typename Hash = hasher<K>>
+class hash_table_view {
+private:
+    static_assert(!std::is_pointer<V>::value, "hash table view: values cannot be pointers, the snapshot would store addresses");
+
+    typedef snapshot_detail::key_format<K> key_format;
+    typedef snapshot_detail::entry<K, V> entry;
+    typedef typename key_format::lookup_key lookup_key;
+
+    void unmap() {
+#ifdef _WIN32
+        delete[] data;
+#else
+        if (data)
+            munmap(data, file_size);
+#endif
+        data = nullptr;
+    }
+
+    void map(const std::string &path) {
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            throw exception("hash table view: cannot open " + path);
+
+        file_size = static_cast<size_t>(file.tellg());
+        data = new char[file_size];
+        file.seekg(0);
+        if (!file.read(data, static_cast<std::streamsize>(file_size))) {
+            unmap();
+            throw exception("hash table view: cannot read " + path);
+        }
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw exception("hash table view: cannot open " + path);
+
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0) {
+            close(fd);
+            throw exception("hash table view: cannot read " + path);
+        }
+
+        file_size = static_cast<size_t>(file_stat.st_size);
+        void *mapped = (file_size > 0) ? mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+        close(fd);
+
+        if (mapped == MAP_FAILED)
+            throw exception("hash table view: cannot map " + path);
+
+        data = static_cast<char *>(mapped);
+#endif
+    }
+
+    bool valid_offset(const uint64_t offset, const uint64_t length) const {
+        return offset % snapshot_detail::section_alignment == 0 && offset <= file_size && length <= file_size - offset;
+    }
+
+    void check_header() {
+        const snapshot_detail::header *h = reinterpret_cast<const snapshot_detail::header *>(data);
+
+        if (file_size < sizeof(snapshot_detail::header) || std::memcmp(h->magic, snapshot_detail::magic, sizeof(h->magic)) != 0)
+            throw exception("hash table view: not a snapshot");
+
+        if (h->byte_order != snapshot_detail::byte_order)
+            throw exception("hash table view: snapshot has a different byte order");
+
+        if (h->key_size != sizeof(typename key_format::stored_key) || h->value_size != sizeof(V) || h->entry_size != sizeof(entry))
+            throw exception("hash table view: snapshot has different key or value types");
+
+        if (h->table_size == 0
+            || h->table_size > file_size / sizeof(uint64_t)
+            || h->num_entries > file_size / sizeof(entry)
+            || !valid_offset(h->chains_offset, (h->table_size + 1) * sizeof(uint64_t))
+            || !valid_offset(h->entries_offset, h->num_entries * sizeof(entry))
+            || !valid_offset(h->strings_offset, h->strings_size))
+            throw exception("hash table view: snapshot is truncated or corrupted");
+    }
+
+    const entry *find_entry(const lookup_key &key) const {
+        uint64_t hash_value = hash_function(key);
+        uint64_t index = hash_value % table_size_;
+
+        // the chain offsets are not checked when the file is opened, a corrupted file must not lead outside the entries
+        const entry *e = entries + ((chains[index] < size_) ? chains[index] : size_);
+        const entry *chain_end = entries + ((chains[index + 1] < size_) ? chains[index + 1] : size_);
+        for (; e < chain_end; ++e) {
+            if (e->hash_value == hash_value && key_format::equals(key, e->key, strings, strings_size))
+                return e;
+        }
+
+        return nullptr;
+    }
+
+    // VARIABLES
+
+    char *data;
+    size_t file_size;
+    size_t size_;
+    size_t table_size_;
+    const uint64_t *chains;
+    const entry *entries;
+    const char *strings;
+    uint64_t strings_size;
+    Hash hash_function;
+
+public:
+    // CLASS
+
+    // constructor (O(1): the entries are only read from the file when they are accessed)
+    hash_table_view(const std::string &path):
+        data(nullptr),
+        file_size(0),
+        size_(0),
+        table_size_(0),
+        chains(nullptr),
+        entries(nullptr),
+        strings(nullptr),
+        strings_size(0),
+        hash_function()
+    {
+        map(path);
+
+        try {
+            check_header();
+        }
+        catch (...) {
+            unmap();
+            throw;
+        }
+
+        const snapshot_detail::header *h = reinterpret_cast<const snapshot_detail::header *>(data);
+        size_ = h->num_entries;
+        table_size_ = h->table_size;
+        chains = reinterpret_cast<const uint64_t *>(data + h->chains_offset);
+        entries = reinterpret_cast<const entry *>(data + h->entries_offset);
+        strings = data + h->strings_offset;
+        strings_size = h->strings_size;
+    }
+
+    hash_table_view(const hash_table_view &other) = delete;
+    hash_table_view &operator=(const hash_table_view &other) = delete;
+
+    // destructor
+    ~hash_table_view() {
+        unmap();
+    }
+
+    friend void swap(hash_table_view &first, hash_table_view &second) noexcept {
+        using std::swap;
+        swap(first.data, second.data);
+        swap(first.file_size, second.file_size);
+        swap(first.size_, second.size_);
+        swap(first.table_size_, second.table_size_);
+        swap(first.chains, second.chains);
+        swap(first.entries, second.entries);
+        swap(first.strings, second.strings);
+        swap(first.strings_size, second.strings_size);
+        swap(first.hash_function, second.hash_function);
+    }
+
+    // move constructor
+    hash_table_view(hash_table_view &&other) noexcept:
+        data(nullptr),
+        file_size(0),
+        size_(0),
+        table_size_(0),
+        chains(nullptr),
+        entries(nullptr),
+        strings(nullptr),
+        strings_size(0),
+        hash_function()
+    {
+        swap(*this, other);
+    }
+
+    // average: O(1) / worst: O(n)
+    const V &get(const lookup_key &key) const {
+        const entry *e = find_entry(key);
+        if (!e)
+            throw exception("hash table view: get: key not found");
+
+        return e->value;
+    }
+
+    // average: O(1) / worst: O(n)
+    const V &operator[](const lookup_key &key) const {
+        const entry *e = find_entry(key);
+        if (!e)
+            throw exception("hash table view: []: key not found");
+
+        return e->value;
+    }
+
+    // average: O(1) / worst: O(n)
+    bool contains(const lookup_key &key) const {
+        return find_entry(key) != nullptr;
+    }
+
+    // O(1)
+    size_t size() const {
+        return size_;
+    }
+
+    // O(1)
+    size_t table_size() const {
+        return table_size_;
+    }
+
+    // O(1)
+    bool empty() const {
+        return size_ == 0;
+    }
+};
+
+}
+
+#endif
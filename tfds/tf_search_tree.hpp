@@ -7,8 +7,15 @@ typedef SSIZE_T ssize_t;
 #endif
 
 #include <algorithm> // std::swap
+#include <cmath> // std::ceil
+#include <iterator> // std::make_move_iterator
+#include <type_traits> // std::enable_if, std::decay, std::is_trivially_destructible
+#include <utility> // std::forward, std::pair
+#include <vector> // std::vector
 #include "utils/tf_exception.hpp"
 #include "utils/tf_compare_functions.hpp"
+#include "utils/tf_pool.hpp"
+#include "utils/tf_parallel.hpp"
 
 namespace tf {
 
@@ -24,19 +31,21 @@ private:
         V value;
         value_bucket *next;
 
-        value_bucket(const V &value, value_bucket *next):
-            value(value), next(next) {}
+        template <typename VV>
+        value_bucket(VV &&value, value_bucket *next):
+            value(std::forward<VV>(value)), next(next) {}
     };
 
-    value_bucket *create_value_bucket(const V &value, value_bucket *next) {
-        value_bucket *b = new value_bucket(value, next);
+    template <typename VV>
+    value_bucket *create_value_bucket(VV &&value, value_bucket *next) {
+        value_bucket *b = bucket_pool.create(std::forward<VV>(value), next);
         ++size_;
         return b;
     }
 
     void destroy_value_bucket(value_bucket *b) {
         --size_;
-        delete b;
+        bucket_pool.destroy(b);
     }
 
     void destroy_all_value_buckets(value_bucket *b) {
@@ -49,21 +58,34 @@ private:
 
     // NODE
 
+    // the values of a node are kept in insertion order, last_bucket is the end of the list
     struct node {
         K key;
         value_bucket *bucket;
+        value_bucket *last_bucket;
         size_t height;
+        // number of values of this node and of all values in its subtree (for rank and select)
+        size_t num_values;
+        size_t count;
         node *parent;
         node *left;
         node *right;
 
-        node(const K &key, value_bucket *bucket, const size_t height, node *parent, node *left, node *right):
-            key(key), bucket(bucket), height(height), parent(parent), left(left), right(right) {}
+        template <typename KK>
+        node(KK &&key, value_bucket *bucket, const size_t height, node *parent, node *left, node *right):
+            key(std::forward<KK>(key)), bucket(bucket), last_bucket(bucket), height(height), num_values(1), count(1), parent(parent), left(left), right(right) {}
     };
 
-    node *create_node(const K &key, const V &value, node *parent) {
-        node *n = new node(key, create_value_bucket(value, nullptr), 1, parent, nullptr, nullptr);
-        return n;
+    template <typename KK, typename VV>
+    node *create_node(KK &&key, VV &&value, node *parent) {
+        value_bucket *b = create_value_bucket(std::forward<VV>(value), nullptr);
+        try {
+            return node_pool.create(std::forward<KK>(key), b, 1, parent, nullptr, nullptr);
+        }
+        catch (...) {
+            destroy_value_bucket(b);
+            throw;
+        }
     }
 
     void destroy_node(node *n, const bool delete_values = true) {
@@ -71,18 +93,46 @@ private:
             destroy_all_value_buckets(n->bucket);
         }
 
-        delete n;
+        node_pool.destroy(n);
+    }
+
+    // the memory of the nodes and buckets is released with the pools, only the keys and values have to be destroyed
+    static void destroy_values(node *n) {
+        if (!std::is_trivially_destructible<value_bucket>::value) {
+            value_bucket *b = n->bucket;
+            while (b) {
+                value_bucket *next = b->next;
+                b->~value_bucket();
+                b = next;
+            }
+        }
+
+        n->~node();
     }
 
     size_t node_height(node *n) const {
         return (n) ? n->height : 0;
     }
 
-    void update_height(node *n) {
+    size_t node_count(node *n) const {
+        return (n) ? n->count : 0;
+    }
+
+    // updates the height and the count from the children
+    void update_node(node *n) {
         if (n) {
             size_t left_height = node_height(n->left);
             size_t right_height = node_height(n->right);
             n->height = ((right_height > left_height) ? right_height : left_height) + 1;
+            n->count = node_count(n->left) + n->num_values + node_count(n->right);
+        }
+    }
+
+    // a value was added to (1) or removed from (-1) the node without changing the structure of the tree
+    void update_counts(node *n, const ssize_t difference) {
+        n->num_values += difference;
+        for (node *it = n; it; it = it->parent) {
+            it->count += difference;
         }
     }
 
@@ -127,9 +177,9 @@ private:
         set_right(n, replacing->left);
         set_left(replacing, n);
 
-        update_height(replacing->left);
-        update_height(replacing->right);
-        update_height(replacing);
+        update_node(replacing->left);
+        update_node(replacing->right);
+        update_node(replacing);
         return replacing;
     }
 
@@ -150,9 +200,9 @@ private:
         set_left(n, replacing->right);
         set_right(replacing, n);
 
-        update_height(replacing->left);
-        update_height(replacing->right);
-        update_height(replacing);
+        update_node(replacing->left);
+        update_node(replacing->right);
+        update_node(replacing);
         return replacing;
     }
 
@@ -179,7 +229,7 @@ private:
                 }
             }
 
-            update_height(it);
+            update_node(it);
             it = it->parent;
         }
     }
@@ -277,6 +327,8 @@ private:
         using std::swap;
         swap(to_delete->key, succ->key);
         swap(to_delete->bucket, succ->bucket);
+        swap(to_delete->last_bucket, succ->last_bucket);
+        swap(to_delete->num_values, succ->num_values);
 
         if (succ->right)
             remove_single_parent(succ);
@@ -293,20 +345,585 @@ private:
             remove_leaf(n);
     }
 
+    static bool key_less_than(const K &key, const K &other) {
+        return less_than<K>(key, other);
+    }
+
+    template <typename Q>
+    static bool key_less_than(const Q &key, const K &other) {
+        return less_than(key, other);
+    }
+
+    static bool key_greater_than(const K &key, const K &other) {
+        return greater_than<K>(key, other);
+    }
+
+    template <typename Q>
+    static bool key_greater_than(const Q &key, const K &other) {
+        return greater_than(key, other);
+    }
+
+    // node with the key, nullptr if not found
+    template <typename Q>
+    node *find_node(const Q &key) const {
+        node *it = root;
+        while (it) {
+            if (key_less_than(key, it->key)) {
+                it = it->left;
+            }
+            else if (key_greater_than(key, it->key)) {
+                it = it->right;
+            }
+            else {
+                return it;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // node with the smallest key >= key, nullptr if there is none
+    template <typename Q>
+    node *lower_bound_node(const Q &key) const {
+        node *result = nullptr;
+        node *it = root;
+        while (it) {
+            if (key_greater_than(key, it->key)) {
+                it = it->right;
+            }
+            else {
+                result = it;
+                it = it->left;
+            }
+        }
+
+        return result;
+    }
+
+    // node with the smallest key > key, nullptr if there is none
+    template <typename Q>
+    node *upper_bound_node(const Q &key) const {
+        node *result = nullptr;
+        node *it = root;
+        while (it) {
+            if (key_less_than(key, it->key)) {
+                result = it;
+                it = it->left;
+            }
+            else {
+                it = it->right;
+            }
+        }
+
+        return result;
+    }
+
+    // first node of the range [first, last) or nullptr if the range is empty, stop: first node after the range
+    template <typename Q>
+    node *range_nodes(const Q &first, const Q &last, node *&stop) const {
+        node *first_node = lower_bound_node(first);
+        if (!first_node || !key_greater_than(last, first_node->key))
+            return nullptr;
+
+        stop = lower_bound_node(last);
+        return first_node;
+    }
+
+    // number of values with keys < key
+    template <typename Q>
+    size_t rank_of(const Q &key) const {
+        size_t result = 0;
+        node *it = root;
+        while (it) {
+            if (key_greater_than(key, it->key)) {
+                result += node_count(it->left) + it->num_values;
+                it = it->right;
+            }
+            else {
+                it = it->left;
+            }
+        }
+
+        return result;
+    }
+
+    // node of the value at position index (< size()) in ascending order, index: position among the values of the node
+    node *select_node(size_t &index) const {
+        node *it = root;
+        while (true) {
+            size_t left_count = node_count(it->left);
+            if (index < left_count) {
+                it = it->left;
+            }
+            else if (index < left_count + it->num_values) {
+                index -= left_count;
+                return it;
+            }
+            else {
+                index -= left_count + it->num_values;
+                it = it->right;
+            }
+        }
+    }
+
+    // position of the value at percentile p (nearest rank)
+    size_t percentile_index(const double p) const {
+        if (empty())
+            throw exception("search tree: percentile: tree is empty");
+
+        if (!(p >= 0.0 && p <= 100.0))
+            throw exception("search tree: percentile: percentile has to be between 0 and 100");
+
+        size_t rank = static_cast<size_t>(std::ceil(p * size_ / 100.0));
+        return (rank > 0) ? rank - 1 : 0;
+    }
+
+    // removes the first value of the node
+    V remove_first_value(node *n) {
+        value_bucket *to_delete = n->bucket;
+        V result = to_delete->value;
+
+        if (to_delete->next) {
+            n->bucket = to_delete->next;
+            destroy_value_bucket(to_delete);
+            update_counts(n, -1);
+        }
+        else {
+            remove_node(n);
+        }
+
+        return result;
+    }
+
+    // BULK LOADING
+
+    // copies the node n with its values (in the same order) and its subtree below parent, the copies
+    // are linked into the tree before their children are copied, so that clear() can destroy a partial copy
+    void clone_subtree(const node *n, node *parent, node *&link) {
+        node *copy = create_node(n->key, n->bucket->value, parent);
+        link = copy;
+
+        for (value_bucket *b = n->bucket->next; b; b = b->next) {
+            copy->last_bucket->next = create_value_bucket(b->value, nullptr);
+            copy->last_bucket = copy->last_bucket->next;
+        }
+
+        copy->height = n->height;
+        copy->num_values = n->num_values;
+        copy->count = n->count;
+
+        if (n->left)
+            clone_subtree(n->left, copy, copy->left);
+        if (n->right)
+            clone_subtree(n->right, copy, copy->right);
+    }
+
+    // links the nodes[first, last) (sorted by key) into a perfectly balanced subtree, returns its root
+    node *link_balanced(const std::vector<node *> &nodes, const size_t first, const size_t last, node *parent) {
+        if (first == last)
+            return nullptr;
+
+        size_t middle = first + (last - first) / 2;
+        node *n = nodes[middle];
+        n->parent = parent;
+        n->left = link_balanced(nodes, first, middle, n);
+        n->right = link_balanced(nodes, middle + 1, last, n);
+        update_node(n);
+        return n;
+    }
+
+    // builds the (empty) tree from the pairs (.first: key, .second: value) of [first, last), which are sorted by key
+    template <typename It>
+    void build_sorted(It first, It last, const char *not_sorted_error, const char *duplicate_error) {
+        std::vector<node *> nodes;
+
+        try {
+            for (; first != last; ++first) {
+                auto &&pair = *first;
+                if (!nodes.empty() && !key_greater_than(pair.first, nodes.back()->key)) {
+                    if (key_less_than(pair.first, nodes.back()->key))
+                        throw exception(not_sorted_error);
+
+                    if (!allow_duplicate_keys)
+                        throw exception(duplicate_error);
+
+                    // values with equal keys keep the order of the range
+                    node *n = nodes.back();
+                    n->last_bucket->next = create_value_bucket(std::forward<decltype(pair)>(pair).second, nullptr);
+                    n->last_bucket = n->last_bucket->next;
+                    ++n->num_values;
+                    continue;
+                }
+
+                nodes.push_back(nullptr);
+                nodes.back() = create_node(std::forward<decltype(pair)>(pair).first, std::forward<decltype(pair)>(pair).second, nullptr);
+            }
+        }
+        catch (...) {
+            for (node *n : nodes) {
+                if (n)
+                    destroy_node(n);
+            }
+
+            throw;
+        }
+
+        root = link_balanced(nodes, 0, nodes.size(), nullptr);
+    }
+
+    // moves the node n of the other tree with its values and its subtree below parent into new nodes of this tree
+    void move_subtree(search_tree &from, node *n, node *parent, node *&link) {
+        node *copy = create_node(std::move(n->key), std::move(n->bucket->value), parent);
+        link = copy;
+
+        for (value_bucket *b = n->bucket->next; b; b = b->next) {
+            copy->last_bucket->next = create_value_bucket(std::move(b->value), nullptr);
+            copy->last_bucket = copy->last_bucket->next;
+        }
+
+        copy->height = n->height;
+        copy->num_values = n->num_values;
+        copy->count = n->count;
+
+        if (n->left)
+            move_subtree(from, n->left, copy, copy->left);
+        if (n->right)
+            move_subtree(from, n->right, copy, copy->right);
+
+        from.destroy_node(n);
+    }
+
+    // JOIN AND SPLIT
+    // (of detached subtrees: the parent of a returned subtree root is not set)
+
+    // number of entries in both trees from which the set operations work on two subtrees in parallel
+    static const size_t min_parallel_count = 16384;
+
+    // links left and right as the children of middle
+    node *link_children(node *left, node *middle, node *right) {
+        middle->left = left;
+        if (left)
+            left->parent = middle;
+
+        middle->right = right;
+        if (right)
+            right->parent = middle;
+
+        update_node(middle);
+        return middle;
+    }
+
+    node *detached_left_rotation(node *n) {
+        node *replacing = n->right;
+        link_children(n->left, n, replacing->left);
+        return link_children(n, replacing, replacing->right);
+    }
+
+    node *detached_right_rotation(node *n) {
+        node *replacing = n->left;
+        link_children(replacing->right, n, n->right);
+        return link_children(replacing->left, replacing, n);
+    }
+
+    // left is higher than right + 1: middle and right are joined into the right spine of left
+    node *join_right(node *left, node *middle, node *right) {
+        node *inner = left->right;
+        if (node_height(inner) <= node_height(right) + 1) {
+            node *joined = link_children(inner, middle, right);
+            if (node_height(joined) <= node_height(left->left) + 1)
+                return link_children(left->left, left, joined);
+
+            return detached_left_rotation(link_children(left->left, left, detached_right_rotation(joined)));
+        }
+
+        node *joined = join_right(inner, middle, right);
+        node *result = link_children(left->left, left, joined);
+        if (node_height(joined) <= node_height(left->left) + 1)
+            return result;
+
+        return detached_left_rotation(result);
+    }
+
+    // right is higher than left + 1: left and middle are joined into the left spine of right
+    node *join_left(node *left, node *middle, node *right) {
+        node *inner = right->left;
+        if (node_height(inner) <= node_height(left) + 1) {
+            node *joined = link_children(left, middle, inner);
+            if (node_height(joined) <= node_height(right->right) + 1)
+                return link_children(joined, right, right->right);
+
+            return detached_right_rotation(link_children(detached_left_rotation(joined), right, right->right));
+        }
+
+        node *joined = join_left(left, middle, inner);
+        node *result = link_children(joined, right, right->right);
+        if (node_height(joined) <= node_height(right->right) + 1)
+            return result;
+
+        return detached_right_rotation(result);
+    }
+
+    // O(|height(left) - height(right)|): AVL tree of the subtrees and the node middle
+    // (all keys of left < key of middle < all keys of right)
+    node *join_nodes(node *left, node *middle, node *right) {
+        if (node_height(left) > node_height(right) + 1)
+            return join_right(left, middle, right);
+
+        if (node_height(right) > node_height(left) + 1)
+            return join_left(left, middle, right);
+
+        return link_children(left, middle, right);
+    }
+
+    // removes the node with the largest key from the subtree n, returns the remaining subtree
+    node *split_last(node *n, node *&last) {
+        if (!n->right) {
+            last = n;
+            return n->left;
+        }
+
+        node *remaining = split_last(n->right, last);
+        return join_nodes(n->left, n, remaining);
+    }
+
+    // O(log(n)): AVL tree of both subtrees (all keys of left < all keys of right)
+    node *join_two(node *left, node *right) {
+        if (!left)
+            return right;
+
+        node *last;
+        node *remaining = split_last(left, last);
+        return join_nodes(remaining, last, right);
+    }
+
+    // O(log(n)): splits the subtree n into the keys < key (left), the node with the key (middle) and the keys > key (right)
+    template <typename Q>
+    void split_nodes(node *n, const Q &key, node *&left, node *&middle, node *&right) {
+        if (!n) {
+            left = middle = right = nullptr;
+            return;
+        }
+
+        node *n_left = n->left;
+        node *n_right = n->right;
+        if (key_less_than(key, n->key)) {
+            node *right_part;
+            split_nodes(n_left, key, left, middle, right_part);
+            right = join_nodes(right_part, n, n_right);
+        }
+        else if (key_greater_than(key, n->key)) {
+            node *left_part;
+            split_nodes(n_right, key, left_part, middle, right);
+            left = join_nodes(n_left, n, left_part);
+        }
+        else {
+            left = n_left;
+            right = n_right;
+            middle = link_children(nullptr, n, nullptr);
+        }
+    }
+
+    // number of levels of the recursion on which the set operations split their work between two threads
+    static size_t parallel_depth(size_t num_threads) {
+        if (num_threads == 0)
+            num_threads = default_num_threads();
+
+        size_t depth = 0;
+        while ((static_cast<size_t>(1) << depth) < num_threads) {
+            ++depth;
+        }
+
+        return depth;
+    }
+
+    // runs both tasks, on two threads if depth > 0 and the subtrees have at least min_parallel_count entries
+    template <typename L, typename R>
+    static void run_both(const size_t depth, const size_t count, L left_task, R right_task) {
+        if (depth > 0 && count >= min_parallel_count) {
+            run_parallel(2, [&left_task, &right_task](const size_t i) {
+                if (i == 0)
+                    left_task();
+                else
+                    right_task();
+            });
+        }
+        else {
+            left_task();
+            right_task();
+        }
+    }
+
+    static void collect_nodes(node *n, std::vector<node *> &nodes) {
+        if (n) {
+            nodes.push_back(n);
+            collect_nodes(n->left, nodes);
+            collect_nodes(n->right, nodes);
+        }
+    }
+
+    // union of the subtrees a (of this tree) and b (of the other tree), the nodes of b with keys of a are
+    // added to dropped (without their values if duplicate keys are allowed, these are added to the node of a)
+    node *unite_nodes(node *a, node *b, std::vector<node *> &dropped, const size_t depth) {
+        if (!a)
+            return b;
+        if (!b)
+            return a;
+
+        size_t count = a->count + b->count;
+        node *b_left, *b_middle, *b_right;
+        split_nodes(b, a->key, b_left, b_middle, b_right);
+
+        node *a_left = a->left;
+        node *a_right = a->right;
+        node *left, *right;
+        std::vector<node *> right_dropped;
+        size_t next_depth = (depth > 0) ? depth - 1 : 0;
+        run_both(depth, count,
+            [&]() { left = unite_nodes(a_left, b_left, dropped, next_depth); },
+            [&]() { right = unite_nodes(a_right, b_right, right_dropped, next_depth); });
+        dropped.insert(dropped.end(), right_dropped.begin(), right_dropped.end());
+
+        if (b_middle) {
+            if (allow_duplicate_keys) {
+                a->last_bucket->next = b_middle->bucket;
+                a->last_bucket = b_middle->last_bucket;
+                a->num_values += b_middle->num_values;
+                b_middle->bucket = nullptr;
+            }
+
+            dropped.push_back(b_middle);
+        }
+
+        return join_nodes(left, a, right);
+    }
+
+    // intersection of the subtrees a (of this tree) and b (of the other tree), the nodes of a without keys of b are added to dropped
+    node *intersect_nodes(node *a, const node *b, std::vector<node *> &dropped, const size_t depth) {
+        if (!a)
+            return nullptr;
+
+        if (!b) {
+            collect_nodes(a, dropped);
+            return nullptr;
+        }
+
+        size_t count = a->count + b->count;
+        node *a_left, *a_middle, *a_right;
+        split_nodes(a, b->key, a_left, a_middle, a_right);
+
+        node *left, *right;
+        std::vector<node *> right_dropped;
+        size_t next_depth = (depth > 0) ? depth - 1 : 0;
+        run_both(depth, count,
+            [&]() { left = intersect_nodes(a_left, b->left, dropped, next_depth); },
+            [&]() { right = intersect_nodes(a_right, b->right, right_dropped, next_depth); });
+        dropped.insert(dropped.end(), right_dropped.begin(), right_dropped.end());
+
+        return (a_middle) ? join_nodes(left, a_middle, right) : join_two(left, right);
+    }
+
+    // difference of the subtrees a (of this tree) and b (of the other tree), the nodes of a with keys of b are added to dropped
+    node *subtract_nodes(node *a, const node *b, std::vector<node *> &dropped, const size_t depth) {
+        if (!a)
+            return nullptr;
+        if (!b)
+            return a;
+
+        size_t count = a->count + b->count;
+        node *a_left, *a_middle, *a_right;
+        split_nodes(a, b->key, a_left, a_middle, a_right);
+        if (a_middle)
+            dropped.push_back(a_middle);
+
+        node *left, *right;
+        std::vector<node *> right_dropped;
+        size_t next_depth = (depth > 0) ? depth - 1 : 0;
+        run_both(depth, count,
+            [&]() { left = subtract_nodes(a_left, b->left, dropped, next_depth); },
+            [&]() { right = subtract_nodes(a_right, b->right, right_dropped, next_depth); });
+        dropped.insert(dropped.end(), right_dropped.begin(), right_dropped.end());
+
+        return join_two(left, right);
+    }
+
+    // sets the new root and destroys the dropped nodes of a set operation
+    void finish_set_operation(node *new_root, std::vector<node *> &dropped) {
+        root = new_root;
+        if (root)
+            root->parent = nullptr;
+
+        for (node *n : dropped) {
+            destroy_node(n);
+        }
+    }
+
+    template <typename Q>
+    search_tree split_at_key(const Q &key) {
+        node *left, *middle, *right;
+        split_nodes(root, key, left, middle, right);
+        if (middle)
+            right = join_nodes(nullptr, middle, right);
+
+        if (left)
+            left->parent = nullptr;
+        if (right)
+            right->parent = nullptr;
+
+        search_tree result(allow_duplicate_keys);
+        if (node_count(right) > node_count(left)) {
+            // the result takes over the memory, the left part is moved into new nodes
+            swap(node_pool, result.node_pool);
+            swap(bucket_pool, result.bucket_pool);
+            result.root = right;
+            result.size_ = size_;
+            root = nullptr;
+            size_ = 0;
+
+            if (left)
+                move_subtree(result, left, nullptr, root);
+        }
+        else {
+            root = left;
+            if (right)
+                result.move_subtree(*this, right, nullptr, result.root);
+        }
+
+        return result;
+    }
+
+    // enables the lookup overloads for types that are compared without constructing a K (see is_lookup_key)
+    template <typename Q>
+    using if_lookup_key = typename std::enable_if<is_lookup_key<K, typename std::decay<Q>::type>::value, int>::type;
+
     // VARIABLES
 
     size_t size_;
     bool allow_duplicate_keys;
-    node *root;   
+    node *root;
+    pool<node> node_pool;
+    pool<value_bucket> bucket_pool;
 
 public:
     // ITERATORS
 
     class iterator {
     private:
+        friend class search_tree;
+
         search_tree *tree;
         value_bucket *current_bucket;
         node *current_node;
+        // iterators over a range stop at these nodes (nullptr: no limit)
+        node *first_node;
+        node *stop_node;
+
+        // positioned at n (no value if n is nullptr)
+        iterator(search_tree *tree, node *n, node *first_node, node *stop_node):
+            tree(tree),
+            current_bucket((n) ? n->bucket : nullptr),
+            current_node(n),
+            first_node(first_node),
+            stop_node(stop_node) {}
 
         void next_bucket() {
             if (current_bucket->next) {
@@ -315,6 +932,9 @@ public:
             }
 
             current_node = tree->successor(current_node);
+            if (current_node == stop_node)
+                current_node = nullptr;
+
             if (current_node)
                 current_bucket = current_node->bucket;
             else
@@ -327,7 +947,11 @@ public:
                 return;
             }
 
-            current_node = tree->predecessor(current_node);
+            if (current_node == first_node)
+                current_node = nullptr;
+            else
+                current_node = tree->predecessor(current_node);
+
             if (current_node)
                 current_bucket = current_node->bucket;
             else
@@ -336,7 +960,9 @@ public:
     
     public:
         iterator(search_tree *tree, const bool forward):
-            tree(tree)
+            tree(tree),
+            first_node(nullptr),
+            stop_node(nullptr)
         {
             if (forward)
                 current_node = tree->min_node(tree->root);
@@ -359,9 +985,22 @@ public:
 
     class const_iterator {
     private:
+        friend class search_tree;
+
         const search_tree *tree;
         value_bucket *current_bucket;
         node *current_node;
+        // iterators over a range stop at these nodes (nullptr: no limit)
+        node *first_node;
+        node *stop_node;
+
+        // positioned at n (no value if n is nullptr)
+        const_iterator(const search_tree *tree, node *n, node *first_node, node *stop_node):
+            tree(tree),
+            current_bucket((n) ? n->bucket : nullptr),
+            current_node(n),
+            first_node(first_node),
+            stop_node(stop_node) {}
 
         void next_bucket() {
             if (current_bucket->next) {
@@ -370,6 +1009,9 @@ public:
             }
 
             current_node = tree->successor(current_node);
+            if (current_node == stop_node)
+                current_node = nullptr;
+
             if (current_node)
                 current_bucket = current_node->bucket;
             else
@@ -382,7 +1024,11 @@ public:
                 return;
             }
 
-            current_node = tree->predecessor(current_node);
+            if (current_node == first_node)
+                current_node = nullptr;
+            else
+                current_node = tree->predecessor(current_node);
+
             if (current_node)
                 current_bucket = current_node->bucket;
             else
@@ -391,7 +1037,9 @@ public:
     
     public:
         const_iterator(const search_tree *tree, const bool forward):
-            tree(tree)
+            tree(tree),
+            first_node(nullptr),
+            stop_node(nullptr)
         {
             if (forward)
                 current_node = tree->min_node(tree->root);
@@ -420,14 +1068,27 @@ public:
         allow_duplicate_keys(allow_duplicate_keys),
         root(nullptr) {}
 
-    // copy constructor
+    // O(n): builds a perfectly balanced tree from the pairs (.first: key, .second: value) of [first, last), which have to
+    // be sorted by key (in ascending order, the pairs are moved with std::make_move_iterator)
+    template <typename It>
+    search_tree(It first, It last, const bool allow_duplicate_keys = false):
+        search_tree(allow_duplicate_keys)
+    {
+        build_sorted(first, last, "search tree: bulk load: keys are not sorted", "search tree: bulk load: key already exists");
+    }
+
+    // copy constructor, O(n): copies the structure of the other tree without comparing keys
     search_tree(const search_tree &other):
-        size_(0),
-        allow_duplicate_keys(other.allow_duplicate_keys),
-        root(nullptr)
+        search_tree(other.allow_duplicate_keys)
     {
-        for (auto it = other.begin(); it.has_value(); ++it) {
-            insert(it.key(), it.value());
+        if (other.root) {
+            // without duplicate keys, every value has its own node
+            if (!allow_duplicate_keys)
+                node_pool.reserve(other.size_);
+            bucket_pool.reserve(other.size_);
+
+            // if an exception is thrown, the destructor (this constructor delegates) destroys the copied nodes
+            clone_subtree(other.root, nullptr, root);
         }
     }
     
@@ -441,6 +1102,8 @@ public:
         swap(first.size_, second.size_);
         swap(first.allow_duplicate_keys, second.allow_duplicate_keys);
         swap(first.root, second.root);
+        swap(first.node_pool, second.node_pool);
+        swap(first.bucket_pool, second.bucket_pool);
     }
 
     // move constructor
@@ -485,7 +1148,10 @@ public:
                         throw exception("search tree: insert: key already exists");
                     }
 
-                    it->bucket = create_value_bucket(value, it->bucket);
+                    // appended, so the values of a key are in insertion order (like with bulk loading and insert_many)
+                    it->last_bucket->next = create_value_bucket(value, nullptr);
+                    it->last_bucket = it->last_bucket->next;
+                    update_counts(it, 1);
                     return;
                 }
             }
@@ -494,58 +1160,78 @@ public:
         }
     }
 
-    // O(log(n))
-    const V &get(const K &key) const {
-        node *it = root;
-        while (it) {
-            if (less_than<K>(key, it->key)) {
-                it = it->left;
-            }
-            else if (greater_than<K>(key, it->key)) {
-                it = it->right;
-            }
-            else {
-                return it->bucket->value;
+    // O(n + m * log(m) / number of threads) for m pairs: inserts the pairs (.first: key, .second: value) of [first, last)
+    // (in any order) by sorting them on num_threads threads (0: one per core) and rebuilding a perfectly balanced tree
+    // from the sorted pairs and the entries of the tree. If an exception is thrown (for example because a key already
+    // exists), the tree is not changed. Inserting a few pairs into a large tree is faster with insert()
+    template <typename It>
+    void insert_many(It first, It last, const size_t num_threads = 0) {
+        std::vector<std::pair<K, V>> pairs;
+        for (; first != last; ++first) {
+            auto &&pair = *first;
+            pairs.emplace_back(std::forward<decltype(pair)>(pair).first, std::forward<decltype(pair)>(pair).second);
+        }
+
+        if (pairs.empty())
+            return;
+
+        parallel_sort(pairs.begin(), pairs.end(), [](const std::pair<K, V> &a, const std::pair<K, V> &b) {
+            return less_than<K>(a.first, b.first);
+        }, num_threads);
+
+        if (!empty()) {
+            // the entries of the tree come before new pairs with the same key
+            std::vector<std::pair<K, V>> merged;
+            merged.reserve(size_ + pairs.size());
+
+            size_t i = 0;
+            const search_tree &self = *this;
+            const_iterator it = self.begin();
+            while (it.has_value() || i < pairs.size()) {
+                if (i == pairs.size() || (it.has_value() && !key_less_than(pairs[i].first, it.key()))) {
+                    merged.emplace_back(it.key(), it.value());
+                    ++it;
+                }
+                else {
+                    merged.push_back(std::move(pairs[i]));
+                    ++i;
+                }
             }
+
+            pairs.swap(merged);
         }
 
-        throw exception("search tree: get: key not found");
+        search_tree result(allow_duplicate_keys);
+        result.build_sorted(std::make_move_iterator(pairs.begin()), std::make_move_iterator(pairs.end()),
+            "search tree: insert_many: keys are not sorted", "search tree: insert_many: key already exists");
+        swap(*this, result);
+    }
+
+    // O(log(n))
+    const V &get(const K &key) const {
+        node *n = find_node(key);
+        if (!n)
+            throw exception("search tree: get: key not found");
+
+        return n->bucket->value;
     }
 
     // O(log(n))
     V &operator[](const K &key) {
-        node *it = root;
-        while (it) {
-            if (less_than<K>(key, it->key)) {
-                it = it->left;
-            }
-            else if (greater_than<K>(key, it->key)) {
-                it = it->right;
-            }
-            else {
-                return it->bucket->value;
-            }
-        }
+        node *n = find_node(key);
+        if (!n)
+            throw exception("search tree: []: key not found");
 
-        throw exception("search tree: []: key not found");
+        return n->bucket->value;
     }
 
     // O(log(n))
     const V &operator[](const K &key) const {
-        node *it = root;
-        while (it) {
-            if (less_than<K>(key, it->key)) {
-                it = it->left;
-            }
-            else if (greater_than<K>(key, it->key)) {
-                it = it->right;
-            }
-            else {
-                return it->bucket->value;
-            }
-        }
+        node *n = find_node(key);
+        if (!n)
+            throw exception("search tree: []: key not found");
 
-        throw exception("search tree: []: key not found");
+        return n->bucket->value;
     }
 
     // O(log(n))
@@ -585,19 +1271,7 @@ public:
         if (empty())
             throw exception("search tree: pop_min: tree is empty");
 
-        node *n = min_node(root);
-        value_bucket *to_delete = n->bucket;
-        V result = to_delete->value;
-
-        if (to_delete->next) {
-            n->bucket = to_delete->next;
-            destroy_value_bucket(to_delete);
-        }
-        else {
-            remove_node(n);
-        }
-        
-        return result;
+        return remove_first_value(min_node(root));
     }
 
     // O(log(n))
@@ -605,48 +1279,16 @@ public:
         if (empty())
             throw exception("search tree: pop_max: tree is empty");
         
-        node *n = max_node(root);
-        value_bucket *to_delete = n->bucket;
-        V result = to_delete->value;
-
-        if (to_delete->next) {
-            n->bucket = to_delete->next;
-            destroy_value_bucket(to_delete);
-        }
-        else {
-            remove_node(n);
-        }
-        
-        return result;
+        return remove_first_value(max_node(root));
     }
 
     // O(log(n))
     V remove(const K &key) {
-        node *it = root;
-        while (it) {
-            if (less_than<K>(key, it->key)) {
-                it = it->left;
-            }
-            else if (greater_than<K>(key, it->key)) {
-                it = it->right;
-            }
-            else {
-                value_bucket *to_delete = it->bucket;
-                V result = to_delete->value;
-
-                if (to_delete->next) {
-                    it->bucket = to_delete->next;
-                    destroy_value_bucket(to_delete);
-                }
-                else {
-                    remove_node(it);
-                }
-
-                return result;
-            }
-        }
+        node *n = find_node(key);
+        if (!n)
+            throw exception("search tree: remove: key not found");
 
-        throw exception("search tree: remove: key not found");
+        return remove_first_value(n);
     }
 
     // O(log(n))
@@ -688,12 +1330,17 @@ public:
 
                         if (prev) {
                             prev->next = bucket_it->next;
+                            if (it->last_bucket == bucket_it)
+                                it->last_bucket = prev;
+
                             destroy_value_bucket(bucket_it);
+                            update_counts(it, -1);
                         }
                         else {
                             if (bucket_it->next) {
                                 it->bucket = bucket_it->next;
                                 destroy_value_bucket(bucket_it);
+                                update_counts(it, -1);
                             }
                             else {
                                 remove_node(it);
@@ -716,20 +1363,7 @@ public:
 
     // O(log(n))
     bool contains(const K &key) const {
-        node *it = root;
-        while (it) {
-            if (less_than<K>(key, it->key)) {
-                it = it->left;
-            }
-            else if (greater_than<K>(key, it->key)) {
-                it = it->right;
-            }
-            else {
-                return true;
-            }
-        }
-
-        return false;
+        return find_node(key) != nullptr;
     }
 
     // O(log(n))
@@ -759,8 +1393,277 @@ public:
         return false;
     }
 
-    // O(n)
+    // O(log(n)), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    const V &get(const Q &key) const {
+        node *n = find_node(key);
+        if (!n)
+            throw exception("search tree: get: key not found");
+
+        return n->bucket->value;
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    V &operator[](const Q &key) {
+        node *n = find_node(key);
+        if (!n)
+            throw exception("search tree: []: key not found");
+
+        return n->bucket->value;
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    const V &operator[](const Q &key) const {
+        node *n = find_node(key);
+        if (!n)
+            throw exception("search tree: []: key not found");
+
+        return n->bucket->value;
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    V remove(const Q &key) {
+        node *n = find_node(key);
+        if (!n)
+            throw exception("search tree: remove: key not found");
+
+        return remove_first_value(n);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    bool contains(const Q &key) const {
+        return find_node(key) != nullptr;
+    }
+
+    // O(log(n)): iterator at the entries with the key (no value if the key does not exist)
+    iterator find(const K &key) {
+        return iterator(this, find_node(key), nullptr, nullptr);
+    }
+
+    // O(log(n)): iterator at the first entry with a key >= key (no value if there is none)
+    iterator lower_bound(const K &key) {
+        return iterator(this, lower_bound_node(key), nullptr, nullptr);
+    }
+
+    // O(log(n)): iterator at the first entry with a key > key (no value if there is none)
+    iterator upper_bound(const K &key) {
+        return iterator(this, upper_bound_node(key), nullptr, nullptr);
+    }
+
+    // O(log(n) + k): iterator over the k entries with first <= key < last, which has no value
+    // after the last entry of the range (++) or before the first one (--)
+    iterator range(const K &first, const K &last) {
+        node *stop = nullptr;
+        node *first_node = range_nodes(first, last, stop);
+        return iterator(this, first_node, first_node, stop);
+    }
+
+    // O(log(n)): iterator at the entries with the key (no value if the key does not exist)
+    const_iterator find(const K &key) const {
+        return const_iterator(this, find_node(key), nullptr, nullptr);
+    }
+
+    // O(log(n)): iterator at the first entry with a key >= key (no value if there is none)
+    const_iterator lower_bound(const K &key) const {
+        return const_iterator(this, lower_bound_node(key), nullptr, nullptr);
+    }
+
+    // O(log(n)): iterator at the first entry with a key > key (no value if there is none)
+    const_iterator upper_bound(const K &key) const {
+        return const_iterator(this, upper_bound_node(key), nullptr, nullptr);
+    }
+
+    // O(log(n) + k): iterator over the k entries with first <= key < last, which has no value
+    // after the last entry of the range (++) or before the first one (--)
+    const_iterator range(const K &first, const K &last) const {
+        node *stop = nullptr;
+        node *first_node = range_nodes(first, last, stop);
+        return const_iterator(this, first_node, first_node, stop);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: iterator at the entries with the key (no value if the key does not exist)
+    template <typename Q, if_lookup_key<Q> = 0>
+    iterator find(const Q &key) {
+        return iterator(this, find_node(key), nullptr, nullptr);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: iterator at the first entry with a key >= key (no value if there is none)
+    template <typename Q, if_lookup_key<Q> = 0>
+    iterator lower_bound(const Q &key) {
+        return iterator(this, lower_bound_node(key), nullptr, nullptr);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: iterator at the first entry with a key > key (no value if there is none)
+    template <typename Q, if_lookup_key<Q> = 0>
+    iterator upper_bound(const Q &key) {
+        return iterator(this, upper_bound_node(key), nullptr, nullptr);
+    }
+
+    // O(log(n) + k), key: std::string_view, C string or other lookup key: iterator over the k entries with first <= key < last, which has no value
+    // after the last entry of the range (++) or before the first one (--)
+    template <typename Q, if_lookup_key<Q> = 0>
+    iterator range(const Q &first, const Q &last) {
+        node *stop = nullptr;
+        node *first_node = range_nodes(first, last, stop);
+        return iterator(this, first_node, first_node, stop);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: iterator at the entries with the key (no value if the key does not exist)
+    template <typename Q, if_lookup_key<Q> = 0>
+    const_iterator find(const Q &key) const {
+        return const_iterator(this, find_node(key), nullptr, nullptr);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: iterator at the first entry with a key >= key (no value if there is none)
+    template <typename Q, if_lookup_key<Q> = 0>
+    const_iterator lower_bound(const Q &key) const {
+        return const_iterator(this, lower_bound_node(key), nullptr, nullptr);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: iterator at the first entry with a key > key (no value if there is none)
+    template <typename Q, if_lookup_key<Q> = 0>
+    const_iterator upper_bound(const Q &key) const {
+        return const_iterator(this, upper_bound_node(key), nullptr, nullptr);
+    }
+
+    // O(log(n) + k), key: std::string_view, C string or other lookup key: iterator over the k entries with first <= key < last, which has no value
+    // after the last entry of the range (++) or before the first one (--)
+    template <typename Q, if_lookup_key<Q> = 0>
+    const_iterator range(const Q &first, const Q &last) const {
+        node *stop = nullptr;
+        node *first_node = range_nodes(first, last, stop);
+        return const_iterator(this, first_node, first_node, stop);
+    }
+
+    // O(log(n) + number of values with the same key): iterator at the value at position index in ascending order
+    iterator select(size_t index) {
+        if (index >= size_)
+            throw exception("search tree: select: index out of range");
+
+        node *n = select_node(index);
+        iterator result(this, n, nullptr, nullptr);
+        for (; index > 0; --index) {
+            ++result;
+        }
+
+        return result;
+    }
+
+    // O(log(n) + number of values with the same key): iterator at the value at percentile p (0 to 100, nearest rank),
+    // for example p = 99: the smallest value that is at least as large as 99% of all values
+    iterator percentile(const double p) {
+        return select(percentile_index(p));
+    }
+
+    // O(log(n) + number of values with the same key): iterator at the value at position index in ascending order
+    const_iterator select(size_t index) const {
+        if (index >= size_)
+            throw exception("search tree: select: index out of range");
+
+        node *n = select_node(index);
+        const_iterator result(this, n, nullptr, nullptr);
+        for (; index > 0; --index) {
+            ++result;
+        }
+
+        return result;
+    }
+
+    // O(log(n) + number of values with the same key): iterator at the value at percentile p (0 to 100, nearest rank),
+    // for example p = 99: the smallest value that is at least as large as 99% of all values
+    const_iterator percentile(const double p) const {
+        return select(percentile_index(p));
+    }
+
+    // O(log(n)): number of values with keys < key
+    size_t rank(const K &key) const {
+        return rank_of(key);
+    }
+
+    // O(log(n)): number of values with first <= key < last
+    size_t count_range(const K &first, const K &last) const {
+        size_t first_rank = rank_of(first);
+        size_t last_rank = rank_of(last);
+        return (last_rank > first_rank) ? last_rank - first_rank : 0;
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: number of values with keys < key
+    template <typename Q, if_lookup_key<Q> = 0>
+    size_t rank(const Q &key) const {
+        return rank_of(key);
+    }
+
+    // O(log(n)), key: std::string_view, C string or other lookup key: number of values with first <= key < last
+    template <typename Q, if_lookup_key<Q> = 0>
+    size_t count_range(const Q &first, const Q &last) const {
+        size_t first_rank = rank_of(first);
+        size_t last_rank = rank_of(last);
+        return (last_rank > first_rank) ? last_rank - first_rank : 0;
+    }
+
+    // O(m * log(n / m + 1)) for m <= n entries in the smaller tree: moves all entries of the other tree into this tree
+    // (pass std::move(other) to avoid copying it). Without duplicate keys, entries of the other tree with keys that
+    // exist in this tree are dropped, otherwise their values are added to the key. Subtrees are merged in parallel
+    // on up to num_threads threads (0: one per core)
+    void unite(search_tree other, const size_t num_threads = 0) {
+        if (other.allow_duplicate_keys && !allow_duplicate_keys)
+            throw exception("search tree: unite: other tree allows duplicate keys");
+
+        node_pool.absorb(other.node_pool);
+        bucket_pool.absorb(other.bucket_pool);
+        size_ += other.size_;
+
+        node *other_root = other.root;
+        other.root = nullptr;
+        other.size_ = 0;
+
+        std::vector<node *> dropped;
+        finish_set_operation(unite_nodes(root, other_root, dropped, parallel_depth(num_threads)), dropped);
+    }
+
+    // O(m * log(n / m + 1)) for m <= n entries in the smaller tree: removes all entries with keys that the other tree
+    // does not contain. Subtrees are processed in parallel on up to num_threads threads (0: one per core)
+    void intersect(const search_tree &other, const size_t num_threads = 0) {
+        if (&other == this)
+            return;
+
+        std::vector<node *> dropped;
+        finish_set_operation(intersect_nodes(root, other.root, dropped, parallel_depth(num_threads)), dropped);
+    }
+
+    // O(m * log(n / m + 1)) for m <= n entries in the smaller tree: removes all entries with keys that the other tree
+    // contains. Subtrees are processed in parallel on up to num_threads threads (0: one per core)
+    void subtract(const search_tree &other, const size_t num_threads = 0) {
+        if (&other == this) {
+            clear();
+            return;
+        }
+
+        std::vector<node *> dropped;
+        finish_set_operation(subtract_nodes(root, other.root, dropped, parallel_depth(num_threads)), dropped);
+    }
+
+    // O(log(n) + number of entries in the smaller part): removes the entries with keys >= key and returns them as a tree.
+    // The larger part keeps the memory of this tree, the entries of the smaller part are moved into new nodes
+    search_tree split_at(const K &key) {
+        return split_at_key(key);
+    }
+
+    // O(log(n) + number of entries in the smaller part), key: std::string_view, C string or other lookup key
+    template <typename Q, if_lookup_key<Q> = 0>
+    search_tree split_at(const Q &key) {
+        return split_at_key(key);
+    }
+
+    // O(1) / O(n) if the keys or values have destructors
     void clear() {
+        if (std::is_trivially_destructible<node>::value && std::is_trivially_destructible<value_bucket>::value)
+            root = nullptr;
+
         node *it = root;
         while (it) {
             if (it->left) {
@@ -783,9 +1686,13 @@ public:
                     root = nullptr;
                 }
 
-                destroy_node(to_delete);
+                destroy_values(to_delete);
             }
         }
+
+        node_pool.release();
+        bucket_pool.release();
+        size_ = 0;
     }
 
     // O(1)
@@ -0,0 +1,171 @@
+#ifndef TF_SHARDED_AGGREGATOR_H
+#define TF_SHARDED_AGGREGATOR_H
+
+#include <vector> // std::vector
+#include <functional> // std::plus
+#include <utility> // std::forward, std::move
+#include <algorithm> // std::swap
+#include <cstdint> // uint64_t
+#include "tf_hash_table.hpp"
+#include "utils/tf_exception.hpp"
+#include "utils/tf_hash_functions.hpp"
+#include "utils/tf_parallel.hpp"
+
+namespace tf {
+
+/*
+* Aggregates (key, value) pairs on several worker threads without locks: every worker adds into
+* its own hash_tables, values with equal keys are combined with combine(old value, value).
+* The tables of every worker are partitioned by hash, so that merge() can combine partition p
+* of all workers on its own thread. The merged results are read from the aggregator.
+* combine is called by several threads at the same time.
+*/
+template <typename K, typename V, typename Combine = std::plus<V>, typename Hash = hasher<K>>
+class sharded_aggregator {
+private:
+    typedef hash_table<K, V, Hash> table;
+
+    // the upper half of the hash selects the partition (the tables use the whole hash for their buckets)
+    size_t partition_of(const uint64_t hash_value) const {
+        return static_cast<size_t>(((hash_value >> 32) * num_partitions_) >> 32);
+    }
+
+    template <typename Q>
+    size_t partition_of_key(const Q &key) const {
+        return partition_of(hash_function(key));
+    }
+
+    // the key is hashed once, the table gets the hash that selected the partition
+    template <typename KK, typename VV>
+    void add_hashed(const size_t worker, KK &&key, VV &&value) {
+        if (worker >= num_workers_)
+            throw exception("sharded aggregator: add: worker out of range");
+
+        uint64_t hash_value = hash_function(key);
+        table_at(worker, partition_of(hash_value)).insert_or_combine_hashed(std::forward<KK>(key), hash_value, std::forward<VV>(value), combine);
+    }
+
+    // tables[worker * num_partitions_ + partition]
+    table &table_at(const size_t worker, const size_t partition) {
+        return tables[worker * num_partitions_ + partition];
+    }
+
+    // combines partition p of all workers into the table of worker 0, starting with the largest table
+    // (the keys are not hashed again: the tables use the same Hash, so the stored hashes are reused)
+    void merge_partition(const size_t p) {
+        size_t largest = 0;
+        for (size_t w = 1; w < num_workers_; ++w) {
+            if (table_at(w, p).size() > table_at(largest, p).size())
+                largest = w;
+        }
+
+        table &target = table_at(0, p);
+        swap(target, table_at(largest, p));
+
+        size_t num_entries = target.size();
+        for (size_t w = 1; w < num_workers_; ++w) {
+            num_entries += table_at(w, p).size();
+        }
+        target.reserve(num_entries);
+
+        for (size_t w = 1; w < num_workers_; ++w) {
+            table &source = table_at(w, p);
+            for (auto it = source.begin(); it.has_value(); ++it) {
+                target.insert_or_combine_hashed(it.key(), it.hash_value(), std::move(it.value()), combine);
+            }
+
+            source.clear();
+        }
+    }
+
+    // VARIABLES
+
+    size_t num_workers_;
+    size_t num_partitions_;
+    Combine combine;
+    Hash hash_function;
+    std::vector<table> tables;
+
+public:
+    // CLASS
+
+    // constructor, num_partitions = 0: one partition per worker
+    sharded_aggregator(const size_t num_workers, const size_t num_partitions = 0, Combine combine = Combine()):
+        num_workers_((num_workers > 0) ? num_workers : 1),
+        num_partitions_((num_partitions > 0) ? num_partitions : num_workers_),
+        combine(combine),
+        hash_function(),
+        tables(num_workers_ * num_partitions_) {}
+
+    // average: O(1) / worst: O(n), only one thread may add to a worker at a time, different workers can be used at the same time
+    template <typename VV>
+    void add(const size_t worker, const K &key, VV &&value) {
+        add_hashed(worker, key, std::forward<VV>(value));
+    }
+
+    // average: O(1) / worst: O(n), only one thread may add to a worker at a time, different workers can be used at the same time
+    template <typename VV>
+    void add(const size_t worker, K &&key, VV &&value) {
+        add_hashed(worker, std::move(key), std::forward<VV>(value));
+    }
+
+    // average: O(n / number of threads), combines the values of all workers on num_threads threads (0: one per core),
+    // every thread merges whole partitions. No worker may add at the same time
+    void merge(const size_t num_threads = 0) {
+        size_t threads = num_threads_for(num_partitions_, num_threads, 1);
+        run_parallel(threads, [this, threads](const size_t t) {
+            for (size_t p = t; p < num_partitions_; p += threads) {
+                merge_partition(p);
+            }
+        });
+    }
+
+    // average: O(1) / worst: O(n), looks up the merged value
+    const V &get(const K &key) const {
+        return tables[partition_of_key(key)].get(key);
+    }
+
+    // average: O(1) / worst: O(n), looks up the merged value
+    bool contains(const K &key) const {
+        return tables[partition_of_key(key)].contains(key);
+    }
+
+    // O(1): merged entries of one partition (iterate over the partitions to visit all merged entries)
+    const table &partition(const size_t p) const {
+        if (p >= num_partitions_)
+            throw exception("sharded aggregator: partition: partition out of range");
+
+        return tables[p];
+    }
+
+    // O(number of tables) / O(n) if the keys or values have destructors
+    void clear() {
+        for (table &t : tables) {
+            t.clear();
+        }
+    }
+
+    // O(number of partitions): number of merged entries
+    size_t size() const {
+        size_t result = 0;
+        for (size_t p = 0; p < num_partitions_; ++p) {
+            result += tables[p].size();
+        }
+
+        return result;
+    }
+
+    // O(1)
+    size_t num_workers() const {
+        return num_workers_;
+    }
+
+    // O(1)
+    size_t num_partitions() const {
+        return num_partitions_;
+    }
+};
+
+}
+
+#endif
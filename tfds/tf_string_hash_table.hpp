@@ -0,0 +1,563 @@
+#ifndef TF_STRING_HASH_TABLE_H
+#define TF_STRING_HASH_TABLE_H
+
+#include <string> // std::string
+#include <string_view> // std::string_view
+#include <vector> // std::vector
+#include <algorithm> // std::swap
+#include <type_traits> // std::is_trivially_destructible
+#include <utility> // std::forward, std::move
+#include <cstring> // std::memcmp, std::memcpy
+#include <functional> // std::less_equal
+#include <cstdint> // uint64_t
+#include <cmath> // std::ceil
+#include <cstdlib> // std::calloc, std::free
+#include <new> // std::bad_alloc
+#include "utils/tf_exception.hpp"
+#include "utils/tf_hash_functions.hpp"
+#include "utils/tf_pool.hpp"
+
+namespace tf {
+
+/*
+* Unordered map with string keys (separate chaining hash map). The characters of all keys are
+* appended to one arena per table and the buckets store their offset and length, so keys need no
+* allocations of their own. The arena is only compacted by compact(). Like hash_table, the table grows
+* when the load factor exceeds the max load factor and migrates its chains incrementally.
+*/
+template <typename V, typename Hash = hasher<std::string>>
+class string_hash_table {
+private:
+    // BUCKET
+
+    struct bucket {
+        uint64_t hash_value;
+        bucket *next;
+        size_t key_offset;
+        size_t key_length;
+        V value;
+
+        template <typename... Args>
+        bucket(const uint64_t hash_value, bucket *next, const size_t key_offset, const size_t key_length, Args &&... args):
+            hash_value(hash_value), next(next), key_offset(key_offset), key_length(key_length), value(std::forward<Args>(args)...) {}
+    };
+
+    // the key is appended to the arena. It can be a view into the arena itself (for example it.key()),
+    // then it is copied through its offset, because growing the arena moves the characters it points to
+    template <typename... Args>
+    bucket *create_bucket(std::string_view key, const uint64_t hash_value, bucket *next, Args &&... args) {
+        size_t key_offset = arena.size();
+        std::less_equal<const char *> before;
+        bool in_arena = key.size() > 0 && before(arena.data(), key.data()) && before(key.data() + key.size(), arena.data() + key_offset);
+        size_t source_offset = in_arena ? static_cast<size_t>(key.data() - arena.data()) : 0;
+
+        arena.resize(key_offset + key.size());
+        if (key.size() > 0)
+            std::memcpy(arena.data() + key_offset, in_arena ? arena.data() + source_offset : key.data(), key.size());
+
+        bucket *b;
+        try {
+            b = bucket_pool.create(hash_value, next, key_offset, key.size(), std::forward<Args>(args)...);
+        }
+        catch (...) {
+            arena.resize(key_offset);
+            throw;
+        }
+
+        ++size_;
+        return b;
+    }
+
+    void destroy_bucket(bucket *b) {
+        --size_;
+        bucket_pool.destroy(b);
+    }
+
+    // the memory of the buckets is released with the pool, only the values have to be destroyed
+    static void destroy_chain_values(bucket *b) {
+        if (!std::is_trivially_destructible<V>::value) {
+            while (b) {
+                bucket *next = b->next;
+                b->~bucket();
+                b = next;
+            }
+        }
+    }
+
+    std::string_view key_of(const bucket *b) const {
+        return std::string_view(arena.data() + b->key_offset, b->key_length);
+    }
+
+    // TABLE
+
+    // calloc gets large tables as fresh pages that the OS zeroes when they are first touched (see hash_table)
+    static bucket **create_table(const size_t table_size) {
+        bucket **table = static_cast<bucket **>(std::calloc(table_size, sizeof(bucket *)));
+        if (!table)
+            throw std::bad_alloc();
+
+        return table;
+    }
+
+    static void destroy_table(bucket **table) {
+        std::free(table);
+    }
+
+    // link (chain head or next pointer) that points to the bucket with the key, nullptr if not found
+    bucket **find_link_in_chain(std::string_view key, const uint64_t hash_value, bucket **link) const {
+        while (*link) {
+            bucket *b = *link;
+            if (b->hash_value == hash_value && b->key_length == key.size()
+                && (key.size() == 0 || std::memcmp(arena.data() + b->key_offset, key.data(), key.size()) == 0)) {
+                return link;
+            }
+
+            link = &b->next;
+        }
+
+        return nullptr;
+    }
+
+    // during a migration, keys can be in the old or in the new table
+    bucket **find_link(std::string_view key, const uint64_t hash_value) const {
+        bucket **link = nullptr;
+        if (old_buckets)
+            link = find_link_in_chain(key, hash_value, &old_buckets[hash_value % old_table_size]);
+
+        if (!link)
+            link = find_link_in_chain(key, hash_value, &buckets[hash_value % table_size_]);
+
+        return link;
+    }
+
+    bucket *find_bucket(std::string_view key) const {
+        bucket **link = find_link(key, hash_function(key));
+        return (link) ? *link : nullptr;
+    }
+
+    // chains of the old table (during a migration) followed by the chains of the current table
+    size_t num_chains() const {
+        return old_table_size + table_size_;
+    }
+
+    bucket *chain_at(const size_t index) const {
+        return (index < old_table_size) ? old_buckets[index] : buckets[index - old_table_size];
+    }
+
+    // moves up to num_chains chains of the old table into the current table
+    // (the cached hashes are reused, the arena is not touched)
+    void migrate(size_t num_chains) {
+        while (old_buckets && num_chains-- > 0) {
+            bucket *b = old_buckets[migrated_chains];
+            while (b) {
+                bucket *next = b->next;
+                uint64_t index = b->hash_value % table_size_;
+                b->next = buckets[index];
+                buckets[index] = b;
+                b = next;
+            }
+
+            old_buckets[migrated_chains] = nullptr;
+            if (++migrated_chains == old_table_size) {
+                destroy_table(old_buckets);
+                old_buckets = nullptr;
+                old_table_size = 0;
+                migrated_chains = 0;
+            }
+        }
+    }
+
+    void finish_migration() {
+        migrate(old_table_size);
+    }
+
+    // the current table becomes the old table, which is then migrated a few chains per insert/remove
+    void start_migration(const size_t new_table_size) {
+        finish_migration();
+
+        bucket **new_buckets = create_table(new_table_size);
+        old_buckets = buckets;
+        old_table_size = table_size_;
+        buckets = new_buckets;
+        table_size_ = new_table_size;
+    }
+
+    size_t min_table_size(const size_t num_entries) const {
+        size_t table_size = static_cast<size_t>(std::ceil(num_entries / max_load_factor_));
+        return (table_size > 0) ? table_size : 1;
+    }
+
+    void grow_if_necessary() {
+        if (size_ > table_size_ * max_load_factor_) {
+            size_t new_table_size = min_table_size(size_);
+            start_migration((new_table_size > table_size_ * 2) ? new_table_size : table_size_ * 2);
+        }
+    }
+
+    template <typename... Args>
+    V &emplace_bucket(std::string_view key, Args &&... args) {
+        migrate(migration_steps);
+
+        uint64_t hash_value = hash_function(key);
+        if (find_link(key, hash_value)) {
+            throw exception("string hash table: insert: key already exists");
+        }
+
+        uint64_t index = hash_value % table_size_;
+        bucket *b = create_bucket(key, hash_value, buckets[index], std::forward<Args>(args)...);
+        buckets[index] = b;
+
+        grow_if_necessary();
+        return b->value;
+    }
+
+    // number of old chains that are migrated with every insert/remove
+    static const size_t migration_steps = 8;
+
+    // VARIABLES
+
+    size_t table_size_;
+    size_t size_;
+    float max_load_factor_;
+    Hash hash_function;
+    pool<bucket> bucket_pool;
+    bucket **buckets;
+    std::vector<char> arena;
+    size_t garbage_size_;
+
+    // migration (old_buckets is nullptr if there is none): chains [0, migrated_chains) of the old table are moved
+    size_t old_table_size;
+    size_t migrated_chains;
+    bucket **old_buckets;
+
+public:
+    // ITERATORS
+
+    class iterator {
+    private:
+        string_hash_table *table;
+        size_t current_index;
+        bucket *current_bucket;
+
+        void next_bucket() {
+            if (current_bucket->next) {
+                current_bucket = current_bucket->next;
+                return;
+            }
+
+            while (++current_index < table->num_chains()) {
+                if (table->chain_at(current_index)) {
+                    current_bucket = table->chain_at(current_index);
+                    return;
+                }
+            }
+
+            current_bucket = nullptr;
+        }
+
+    public:
+        iterator(string_hash_table *table):
+            table(table), current_index(0), current_bucket(table->chain_at(0))
+        {
+            while (!current_bucket && ++current_index < table->num_chains()) {
+                current_bucket = table->chain_at(current_index);
+            }
+        }
+
+        // valid until the next insertion or compact()
+        std::string_view key() const { return table->key_of(current_bucket); }
+        V &operator*() { return current_bucket->value; }
+        V &value() { return current_bucket->value; }
+        void operator++() { next_bucket(); }
+        bool has_value() const { return current_bucket != nullptr; }
+    };
+
+    class const_iterator {
+    private:
+        const string_hash_table *table;
+        size_t current_index;
+        bucket *current_bucket;
+
+        void next_bucket() {
+            if (current_bucket->next) {
+                current_bucket = current_bucket->next;
+                return;
+            }
+
+            while (++current_index < table->num_chains()) {
+                if (table->chain_at(current_index)) {
+                    current_bucket = table->chain_at(current_index);
+                    return;
+                }
+            }
+
+            current_bucket = nullptr;
+        }
+
+    public:
+        const_iterator(const string_hash_table *table):
+            table(table), current_index(0), current_bucket(table->chain_at(0))
+        {
+            while (!current_bucket && ++current_index < table->num_chains()) {
+                current_bucket = table->chain_at(current_index);
+            }
+        }
+
+        // valid until the next insertion or compact()
+        std::string_view key() const { return table->key_of(current_bucket); }
+        const V &operator*() const { return current_bucket->value; }
+        const V &value() const { return current_bucket->value; }
+        void operator++() { next_bucket(); }
+        bool has_value() const { return current_bucket != nullptr; }
+    };
+
+    // CLASS
+
+    // constructor
+    string_hash_table(const size_t table_size = 100):
+        table_size_((table_size > 0) ? table_size : 1),
+        size_(0),
+        max_load_factor_(1.0f),
+        hash_function(),
+        buckets(create_table(table_size_)),
+        garbage_size_(0),
+        old_table_size(0),
+        migrated_chains(0),
+        old_buckets(nullptr) {}
+
+    // copy constructor (the arena of the copy only contains the keys of the entries,
+    // the entries that the other table has not migrated yet are inserted into the current table of the copy)
+    string_hash_table(const string_hash_table &other):
+        table_size_(other.table_size_),
+        size_(0),
+        max_load_factor_(other.max_load_factor_),
+        hash_function(other.hash_function),
+        buckets(create_table(table_size_)),
+        garbage_size_(0),
+        old_table_size(0),
+        migrated_chains(0),
+        old_buckets(nullptr)
+    {
+        bucket_pool.reserve(other.size_);
+        arena.reserve(other.arena.size() - other.garbage_size_);
+
+        for (size_t i = 0; i < other.num_chains(); ++i) {
+            for (bucket *b = other.chain_at(i); b; b = b->next) {
+                uint64_t index = b->hash_value % table_size_;
+                buckets[index] = create_bucket(other.key_of(b), b->hash_value, buckets[index], b->value);
+            }
+        }
+    }
+
+    // destructor
+    ~string_hash_table() {
+        clear();
+        destroy_table(buckets);
+    }
+
+    friend void swap(string_hash_table &first, string_hash_table &second) noexcept {
+        using std::swap;
+        swap(first.table_size_, second.table_size_);
+        swap(first.size_, second.size_);
+        swap(first.max_load_factor_, second.max_load_factor_);
+        swap(first.hash_function, second.hash_function);
+        swap(first.bucket_pool, second.bucket_pool);
+        swap(first.buckets, second.buckets);
+        swap(first.arena, second.arena);
+        swap(first.garbage_size_, second.garbage_size_);
+        swap(first.old_table_size, second.old_table_size);
+        swap(first.migrated_chains, second.migrated_chains);
+        swap(first.old_buckets, second.old_buckets);
+    }
+
+    // move constructor
+    string_hash_table(string_hash_table &&other) noexcept : string_hash_table(1) {
+        swap(*this, other);
+    }
+
+    // copy assignment operator
+    string_hash_table &operator=(string_hash_table other) {
+        swap(*this, other);
+        return *this;
+    }
+
+    // average: O(1) / worst: O(n)
+    void insert(std::string_view key, const V &value) {
+        emplace_bucket(key, value);
+    }
+
+    // average: O(1) / worst: O(n)
+    void insert(std::string_view key, V &&value) {
+        emplace_bucket(key, std::move(value));
+    }
+
+    // average: O(1) / worst: O(n), constructs the value in place from args and returns it
+    template <typename... Args>
+    V &emplace(std::string_view key, Args &&... args) {
+        return emplace_bucket(key, std::forward<Args>(args)...);
+    }
+
+    // average: O(1) / worst: O(n)
+    const V &get(std::string_view key) const {
+        bucket *b = find_bucket(key);
+        if (!b)
+            throw exception("string hash table: get: key not found");
+
+        return b->value;
+    }
+
+    // average: O(1) / worst: O(n)
+    V &operator[](std::string_view key) {
+        bucket *b = find_bucket(key);
+        if (!b)
+            throw exception("string hash table: []: key not found");
+
+        return b->value;
+    }
+
+    // average: O(1) / worst: O(n)
+    const V &operator[](std::string_view key) const {
+        bucket *b = find_bucket(key);
+        if (!b)
+            throw exception("string hash table: []: key not found");
+
+        return b->value;
+    }
+
+    // average: O(1) / worst: O(n), the characters of the key stay in the arena until compact()
+    V remove(std::string_view key) {
+        migrate(migration_steps);
+
+        bucket **link = find_link(key, hash_function(key));
+        if (!link)
+            throw exception("string hash table: remove: key not found");
+
+        bucket *to_delete = *link;
+        *link = to_delete->next;
+        garbage_size_ += to_delete->key_length;
+
+        V result = std::move(to_delete->value);
+        destroy_bucket(to_delete);
+        return result;
+    }
+
+    // average: O(1) / worst: O(n)
+    bool contains(std::string_view key) const {
+        return find_bucket(key) != nullptr;
+    }
+
+    // O(n)
+    void rehash(const size_t table_size) {
+        size_t min_size = min_table_size(size_);
+        start_migration((table_size > min_size) ? table_size : min_size);
+        finish_migration();
+    }
+
+    // O(n), reserves the table for num_entries entries and the arena for num_characters characters
+    void reserve(const size_t num_entries, const size_t num_characters = 0) {
+        size_t table_size = min_table_size(num_entries);
+        if (table_size > table_size_)
+            rehash(table_size);
+
+        arena.reserve(num_characters);
+    }
+
+    // O(1): the table grows when the load factor exceeds the max load factor (default: 1.0)
+    void set_max_load_factor(const float max_load_factor) {
+        if (!(max_load_factor > 0.0f))
+            throw exception("string hash table: set_max_load_factor: max load factor has to be larger than zero");
+
+        max_load_factor_ = max_load_factor;
+    }
+
+    // O(n + arena size): removes the characters of removed keys from the arena
+    void compact() {
+        std::vector<char> compacted;
+        compacted.reserve(arena.size() - garbage_size_);
+
+        for (size_t i = 0; i < num_chains(); ++i) {
+            for (bucket *b = chain_at(i); b; b = b->next) {
+                size_t offset = compacted.size();
+                compacted.insert(compacted.end(), arena.begin() + b->key_offset, arena.begin() + b->key_offset + b->key_length);
+                b->key_offset = offset;
+            }
+        }
+
+        arena.swap(compacted);
+        garbage_size_ = 0;
+    }
+
+    // O(table size) / O(n) if the values have destructors
+    void clear() {
+        for (size_t i = 0; i < table_size_; ++i) {
+            destroy_chain_values(buckets[i]);
+            buckets[i] = nullptr;
+        }
+
+        for (size_t i = 0; i < old_table_size; ++i) {
+            destroy_chain_values(old_buckets[i]);
+        }
+
+        destroy_table(old_buckets);
+        old_buckets = nullptr;
+        old_table_size = 0;
+        migrated_chains = 0;
+
+        bucket_pool.release();
+        arena.clear();
+        garbage_size_ = 0;
+        size_ = 0;
+    }
+
+    // O(1)
+    size_t size() const {
+        return size_;
+    }
+
+    // O(1)
+    size_t table_size() const {
+        return table_size_;
+    }
+
+    // O(1)
+    float load_factor() const {
+        return static_cast<float>(size_) / table_size_;
+    }
+
+    // O(1)
+    float max_load_factor() const {
+        return max_load_factor_;
+    }
+
+    // O(1)
+    bool rehashing() const {
+        return old_buckets != nullptr;
+    }
+
+    // O(1): number of characters in the arena (including the characters of removed keys)
+    size_t arena_size() const {
+        return arena.size();
+    }
+
+    // O(1): number of characters in the arena that belong to removed keys
+    size_t garbage_size() const {
+        return garbage_size_;
+    }
+
+    // O(1)
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    iterator begin() {
+        return iterator(this);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this);
+    }
+};
+
+}
+
+#endif
@@ -2,6 +2,8 @@
 #define TF_COMPARE_FUNCTIONS_H
 
 #include <string> // std::string
+#include <string_view> // std::string_view
+#include <type_traits> // std::false_type, std::true_type
 #include <cstring> // std::strcmp, std::memcpy, std::memset
 
 namespace tf {
@@ -73,6 +75,37 @@ inline bool greater_than<char *>(char * const &s1, char * const &s2) {
     return std::strcmp(s1, s2) > 0;
 }
 
+// LOOKUP KEYS
+
+/*
+* Types Q that can be used in place of the key type K to look up entries (get, contains, remove, []).
+* They are compared with equals/less_than/greater_than(const Q &, const K &) and hashed with hasher<K>,
+* so no K has to be constructed. Specialize for own key types together with these functions.
+*/
+template <typename K, typename Q>
+struct is_lookup_key : std::false_type {};
+
+template <>
+struct is_lookup_key<std::string, std::string_view> : std::true_type {};
+
+template <>
+struct is_lookup_key<std::string, const char *> : std::true_type {};
+
+template <>
+struct is_lookup_key<std::string, char *> : std::true_type {};
+
+inline bool equals(std::string_view key, const std::string &s) {
+    return s.compare(key) == 0;
+}
+
+inline bool less_than(std::string_view key, const std::string &s) {
+    return s.compare(key) > 0;
+}
+
+inline bool greater_than(std::string_view key, const std::string &s) {
+    return s.compare(key) < 0;
+}
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,181 @@
+#ifndef TF_EPOCH_H
+#define TF_EPOCH_H
+
+#include <atomic> // std::atomic, std::atomic_thread_fence
+#include <mutex> // std::mutex, std::lock_guard
+#include <vector> // std::vector
+#include <cstdint> // uint64_t
+#include "tf_exception.hpp"
+
+namespace tf {
+
+namespace epoch_detail {
+
+const size_t max_threads = 256;
+const uint64_t inactive = ~0ULL;
+
+// number of objects a thread retires before it tries to free them
+const size_t retire_threshold = 128;
+
+struct alignas(64) thread_slot {
+    std::atomic<uint64_t> epoch;
+    std::atomic<bool> used;
+
+    thread_slot(): epoch(inactive), used(false) {}
+};
+
+struct retired_object {
+    void *object;
+    void (*deleter)(void *);
+    uint64_t epoch;
+};
+
+struct state {
+    std::atomic<uint64_t> global_epoch;
+    thread_slot slots[max_threads];
+
+    // objects that exited threads could not free yet
+    std::mutex orphans_mutex;
+    std::vector<retired_object> orphans;
+    std::atomic<bool> has_orphans;
+
+    state(): global_epoch(0), has_orphans(false) {}
+
+    // no other thread can access retired objects anymore when the program exits
+    ~state() {
+        for (const retired_object &r : orphans) {
+            r.deleter(r.object);
+        }
+    }
+};
+
+inline state &global_state() {
+    static state s;
+    return s;
+}
+
+// the epoch can only advance if every thread inside a guard has seen the current epoch
+inline bool try_advance(state &s) {
+    uint64_t epoch = s.global_epoch.load(std::memory_order_acquire);
+    for (size_t i = 0; i < max_threads; ++i) {
+        uint64_t thread_epoch = s.slots[i].epoch.load(std::memory_order_acquire);
+        if (thread_epoch != inactive && thread_epoch != epoch)
+            return false;
+    }
+
+    return s.global_epoch.compare_exchange_strong(epoch, epoch + 1);
+}
+
+// every thread occupies one slot and collects the objects it retires while it exists
+struct thread_registration {
+    thread_slot *slot;
+    size_t depth;
+    std::vector<retired_object> retired;
+    size_t collect_at;
+
+    thread_registration(): slot(nullptr), depth(0), collect_at(retire_threshold) {
+        state &s = global_state();
+        for (size_t i = 0; i < max_threads; ++i) {
+            bool expected = false;
+            if (s.slots[i].used.compare_exchange_strong(expected, true)) {
+                slot = &s.slots[i];
+                return;
+            }
+        }
+
+        throw exception("epoch: too many threads");
+    }
+
+    ~thread_registration() {
+        collect();
+
+        state &s = global_state();
+        if (!retired.empty()) {
+            std::lock_guard<std::mutex> lock(s.orphans_mutex);
+            s.orphans.insert(s.orphans.end(), retired.begin(), retired.end());
+            s.has_orphans.store(true, std::memory_order_release);
+        }
+
+        slot->epoch.store(inactive, std::memory_order_release);
+        slot->used.store(false, std::memory_order_release);
+    }
+
+    // frees the objects that were retired at least two epochs ago, no thread inside a guard can reach them
+    void collect() {
+        state &s = global_state();
+        try_advance(s);
+
+        if (s.has_orphans.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(s.orphans_mutex);
+            retired.insert(retired.end(), s.orphans.begin(), s.orphans.end());
+            s.orphans.clear();
+            s.has_orphans.store(false, std::memory_order_release);
+        }
+
+        uint64_t epoch = s.global_epoch.load(std::memory_order_acquire);
+        size_t kept = 0;
+        for (size_t i = 0; i < retired.size(); ++i) {
+            if (retired[i].epoch + 2 <= epoch)
+                retired[i].deleter(retired[i].object);
+            else
+                retired[kept++] = retired[i];
+        }
+
+        retired.resize(kept);
+        collect_at = kept + retire_threshold;
+    }
+};
+
+inline thread_registration &this_thread() {
+    thread_local thread_registration registration;
+    return registration;
+}
+
+}
+
+/*
+* Epoch based memory reclamation: while a thread holds a guard, no object that it could
+* have reached through shared pointers is freed. Guards can be nested.
+*/
+class epoch_guard {
+private:
+    epoch_detail::thread_registration &registration;
+
+public:
+    epoch_guard():
+        registration(epoch_detail::this_thread())
+    {
+        if (registration.depth++ == 0) {
+            registration.slot->epoch.store(epoch_detail::global_state().global_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            // the announced epoch has to be visible before any shared pointer is read
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    epoch_guard(const epoch_guard &other) = delete;
+    epoch_guard &operator=(const epoch_guard &other) = delete;
+
+    ~epoch_guard() {
+        if (--registration.depth == 0) {
+            registration.slot->epoch.store(epoch_detail::inactive, std::memory_order_release);
+        }
+    }
+};
+
+// frees the object as soon as no thread can access it anymore (the object has to be unreachable for new readers)
+inline void retire(void *object, void (*deleter)(void *)) {
+    epoch_detail::thread_registration &registration = epoch_detail::this_thread();
+    registration.retired.push_back({ object, deleter, epoch_detail::global_state().global_epoch.load(std::memory_order_acquire) });
+
+    if (registration.retired.size() >= registration.collect_at)
+        registration.collect();
+}
+
+template <typename T>
+inline void retire(T *object) {
+    retire(object, [](void *o) { delete static_cast<T *>(o); });
+}
+
+}
+
+#endif
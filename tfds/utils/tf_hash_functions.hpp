@@ -0,0 +1,217 @@
+#ifndef TF_HASH_FUNCTIONS_H
+#define TF_HASH_FUNCTIONS_H
+
+#include <cstdint> // uint64_t, uintptr_t
+#include <string> // std::string
+#include <string_view> // std::string_view
+#include <cstring> // std::memcpy, std::strlen
+#include <type_traits> // std::is_integral, std::is_trivially_copyable, std::has_unique_object_representations
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h> // _umul128
+#endif
+
+namespace tf {
+
+namespace hash_detail {
+
+const uint64_t secret[4] = {
+    0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL
+};
+
+// full 64 x 64 -> 128 bit multiplication, a becomes the low and b the high half
+inline void multiply(uint64_t &a, uint64_t &b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    a = static_cast<uint64_t>(r);
+    b = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    a = _umul128(a, b, &b);
+#else
+    uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    a = lo;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+inline uint64_t mix(uint64_t a, uint64_t b) {
+    multiply(a, b);
+    return a ^ b;
+}
+
+inline uint64_t read64(const unsigned char *p) {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint64_t read32(const unsigned char *p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+// 1 to 3 bytes
+inline uint64_t read_small(const unsigned char *p, const size_t length) {
+    return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[length >> 1]) << 8) | p[length - 1];
+}
+
+// one multiplication for keys that fit into 64 bits
+inline uint64_t hash_word(const uint64_t word) {
+    return mix(word ^ secret[0], secret[1]);
+}
+
+// +0.0 and -0.0 are equal, so they need the same hash
+template <typename F>
+inline uint64_t hash_floating_point(const F key) {
+    if (key == 0)
+        return hash_word(0);
+
+    if constexpr (sizeof(F) == sizeof(uint64_t)) {
+        uint64_t bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        return hash_word(bits);
+    }
+    else if constexpr (sizeof(F) == sizeof(uint32_t)) {
+        uint32_t bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        return hash_word(bits);
+    }
+    else {
+        // long double has padding bytes on most platforms
+        return hash_floating_point(static_cast<double>(key));
+    }
+}
+
+}
+
+// src: https://github.com/wangyi-fudan/wyhash (final version 4, public domain)
+// reads 8 bytes per step (48 bytes per loop iteration for long keys in three independent lanes)
+inline uint64_t hash_bytes(const void *key, const size_t length, uint64_t seed = 0) {
+    using namespace hash_detail;
+
+    const unsigned char *p = static_cast<const unsigned char *>(key);
+    seed ^= mix(seed ^ secret[0], secret[1]);
+
+    uint64_t a, b;
+    if (length <= 16) {
+        if (length >= 4) {
+            a = (read32(p) << 32) | read32(p + ((length >> 3) << 2));
+            b = (read32(p + length - 4) << 32) | read32(p + length - 4 - ((length >> 3) << 2));
+        }
+        else if (length > 0) {
+            a = read_small(p, length);
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        size_t i = length;
+        if (i > 48) {
+            uint64_t seed1 = seed, seed2 = seed;
+            do {
+                seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+                seed1 = mix(read64(p + 16) ^ secret[2], read64(p + 24) ^ seed1);
+                seed2 = mix(read64(p + 32) ^ secret[3], read64(p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (i > 16) {
+            seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    multiply(a, b);
+    return mix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+/*
+* Integers, enums and pointers are mixed with one multiplication, other trivially copyable keys without
+* padding bytes are hashed 8 bytes at a time. Other key types need a specialization of tf::hash
+* (or a custom hash function type), for example with hash_combine over their members.
+*/
+template <typename K>
+inline uint64_t hash(const K &key) {
+    if constexpr (std::is_integral<K>::value) {
+        return hash_detail::hash_word(static_cast<uint64_t>(key));
+    }
+    else if constexpr (std::is_enum<K>::value) {
+        return hash_detail::hash_word(static_cast<uint64_t>(static_cast<typename std::underlying_type<K>::type>(key)));
+    }
+    else if constexpr (std::is_pointer<K>::value) {
+        uintptr_t address;
+        std::memcpy(&address, &key, sizeof(address));
+        return hash_detail::hash_word(address);
+    }
+    else if constexpr (std::is_floating_point<K>::value) {
+        return hash_detail::hash_floating_point(key);
+    }
+    else {
+        static_assert(std::is_trivially_copyable<K>::value && std::has_unique_object_representations<K>::value,
+            "tf::hash: keys with padding bytes or that are not trivially copyable need a specialization of tf::hash<K>");
+        return hash_bytes(&key, sizeof(K));
+    }
+}
+
+// combines the hashes of several members, e.g. hash_combine(hash(key.a), hash(key.b))
+inline uint64_t hash_combine(const uint64_t seed, const uint64_t hash_value) {
+    return hash_detail::mix(seed ^ hash_detail::secret[2], hash_value ^ hash_detail::secret[3]);
+}
+
+// C++ strings and C strings with the same text produce the same hash
+
+template <>
+inline uint64_t hash<std::string>(const std::string &key) {
+    return hash_bytes(key.data(), key.size());
+}
+
+template <>
+inline uint64_t hash<const char *>(const char * const &key) {
+    return hash_bytes(key, std::strlen(key));
+}
+
+template <>
+inline uint64_t hash<char *>(char * const &key) {
+    return hash_bytes(key, std::strlen(key));
+}
+
+/*
+* Default hash function object of the hash tables (can be replaced by any type with uint64_t operator()(const K &)).
+* Specialize tf::hash<K> to change the hash of a key type for all tables.
+*/
+template <typename K>
+struct hasher {
+    uint64_t operator()(const K &key) const {
+        return hash<K>(key);
+    }
+};
+
+// also hashes std::string_view and C strings, so that they can look up std::string keys
+template <>
+struct hasher<std::string> {
+    uint64_t operator()(std::string_view key) const {
+        return hash_bytes(key.data(), key.size());
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef TF_PARALLEL_H
+#define TF_PARALLEL_H
+
+#include <thread> // std::thread
+#include <vector> // std::vector
+#include <exception> // std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <algorithm> // std::stable_sort, std::inplace_merge, std::min
+
+namespace tf {
+
+// number of threads that bulk operations use by default (at least 1)
+inline size_t default_num_threads() {
+    size_t num_threads = std::thread::hardware_concurrency();
+    return (num_threads > 0) ? num_threads : 1;
+}
+
+// number of threads for num_items items, so that every thread gets at least min_items_per_thread items
+inline size_t num_threads_for(const size_t num_items, size_t num_threads, const size_t min_items_per_thread) {
+    if (num_threads == 0)
+        num_threads = default_num_threads();
+
+    size_t max_threads = num_items / min_items_per_thread;
+    if (num_threads > max_threads)
+        num_threads = max_threads;
+
+    return (num_threads > 0) ? num_threads : 1;
+}
+
+// runs task(i) for every i in [0, num_tasks) on its own thread (task 0 runs on the calling thread),
+// waits for all tasks and then rethrows the first exception that a task has thrown
+template <typename F>
+void run_parallel(const size_t num_tasks, F task) {
+    std::vector<std::exception_ptr> exceptions(num_tasks);
+    std::vector<std::thread> threads;
+    threads.reserve(num_tasks);
+
+    auto run = [&task, &exceptions](const size_t i) {
+        try {
+            task(i);
+        }
+        catch (...) {
+            exceptions[i] = std::current_exception();
+        }
+    };
+
+    try {
+        for (size_t i = 1; i < num_tasks; ++i) {
+            threads.emplace_back(run, i);
+        }
+    }
+    catch (...) {
+        // the tasks that could not be started run on the calling thread
+        for (size_t i = threads.size() + 1; i < num_tasks; ++i) {
+            run(i);
+        }
+    }
+
+    if (num_tasks > 0)
+        run(0);
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    for (std::exception_ptr &e : exceptions) {
+        if (e)
+            std::rethrow_exception(e);
+    }
+}
+
+// sorts [first, last) (random access iterators) on num_threads threads (0: one per core): every thread sorts
+// a chunk of at least min_items_per_thread items, then neighbouring chunks are merged in rounds on half as many threads.
+// The sort is stable, equal items keep their order
+template <typename It, typename Compare>
+void parallel_sort(It first, It last, Compare compare, const size_t num_threads = 0, const size_t min_items_per_thread = 4096) {
+    size_t num_items = static_cast<size_t>(last - first);
+    size_t num_chunks = num_threads_for(num_items, num_threads, min_items_per_thread);
+
+    std::vector<size_t> chunk_begin(num_chunks + 1);
+    for (size_t c = 0; c <= num_chunks; ++c) {
+        chunk_begin[c] = num_items * c / num_chunks;
+    }
+
+    run_parallel(num_chunks, [&](const size_t c) {
+        std::stable_sort(first + chunk_begin[c], first + chunk_begin[c + 1], compare);
+    });
+
+    for (size_t width = 1; width < num_chunks; width *= 2) {
+        size_t num_merges = (num_chunks + 2 * width - 1) / (2 * width);
+        run_parallel(num_merges, [&](const size_t m) {
+            size_t low = 2 * width * m;
+            size_t middle = std::min(low + width, num_chunks);
+            size_t high = std::min(low + 2 * width, num_chunks);
+            if (middle < high)
+                std::inplace_merge(first + chunk_begin[low], first + chunk_begin[middle], first + chunk_begin[high], compare);
+        });
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef TF_POOL_H
+#define TF_POOL_H
+
+#include <new> // placement new
+#include <utility> // std::forward
+#include <algorithm> // std::swap
+
+namespace tf {
+
+/*
+* Slab allocator for objects of one type: memory is taken from a free list or from
+* slabs of growing size and only returned to the system when the whole pool is released.
+*/
+template <typename T>
+class pool {
+private:
+    // unused nodes store the next free node
+    union node {
+        node *next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static const size_t min_slab_size = 16;
+    static const size_t max_slab_size = 65536;
+
+    void add_slab(const size_t num_nodes) {
+        // the first node of every slab links to the previously allocated slab
+        node *slab = new node[num_nodes + 1];
+        slab[0].next = slabs;
+        slabs = slab;
+        current = slab + 1;
+        current_end = current + num_nodes;
+    }
+
+    // VARIABLES
+
+    node *slabs;
+    node *free_list;
+    node *current;
+    node *current_end;
+    size_t next_slab_size;
+
+public:
+    // CLASS
+
+    // constructor
+    pool():
+        slabs(nullptr),
+        free_list(nullptr),
+        current(nullptr),
+        current_end(nullptr),
+        next_slab_size(min_slab_size) {}
+
+    pool(const pool &other) = delete;
+    pool &operator=(const pool &other) = delete;
+
+    // destructor (does not call the destructors of the objects that are still allocated)
+    ~pool() {
+        release();
+    }
+
+    friend void swap(pool &first, pool &second) noexcept {
+        using std::swap;
+        swap(first.slabs, second.slabs);
+        swap(first.free_list, second.free_list);
+        swap(first.current, second.current);
+        swap(first.current_end, second.current_end);
+        swap(first.next_slab_size, second.next_slab_size);
+    }
+
+    // O(1)
+    T *allocate() {
+        if (free_list) {
+            node *n = free_list;
+            free_list = n->next;
+            return reinterpret_cast<T *>(n);
+        }
+
+        if (current == current_end) {
+            add_slab(next_slab_size);
+            if (next_slab_size < max_slab_size)
+                next_slab_size *= 2;
+        }
+
+        return reinterpret_cast<T *>(current++);
+    }
+
+    // O(1)
+    void deallocate(T *object) {
+        node *n = reinterpret_cast<node *>(object);
+        n->next = free_list;
+        free_list = n;
+    }
+
+    // O(1)
+    template <typename... Args>
+    T *create(Args &&... args) {
+        T *object = allocate();
+        try {
+            return new (object) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            deallocate(object);
+            throw;
+        }
+    }
+
+    // O(1)
+    void destroy(T *object) {
+        object->~T();
+        deallocate(object);
+    }
+
+    // O(1): the next num_objects allocations that do not reuse freed objects are taken from one contiguous block
+    void reserve(const size_t num_objects) {
+        if (static_cast<size_t>(current_end - current) < num_objects)
+            add_slab(num_objects);
+    }
+
+    // O(1): storage for num_objects objects at objects[0..num_objects), which can be constructed by
+    // different threads and are deallocated one by one (only for types that are at least as large as a pointer)
+    T *allocate_contiguous(const size_t num_objects) {
+        static_assert(sizeof(node) == sizeof(T), "pool: allocate_contiguous: objects are smaller than a pointer");
+
+        reserve(num_objects);
+        T *objects = reinterpret_cast<T *>(current);
+        current += num_objects;
+        return objects;
+    }
+
+    // O(number of slabs of the other pool + number of free objects in it): takes over the memory of the other pool,
+    // which becomes empty. Objects allocated from the other pool are then deallocated into this pool
+    void absorb(pool &other) {
+        if (&other == this || !other.slabs)
+            return;
+
+        node *last_slab = other.slabs;
+        while (last_slab[0].next) {
+            last_slab = last_slab[0].next;
+        }
+        last_slab[0].next = slabs;
+        slabs = other.slabs;
+
+        while (other.free_list) {
+            node *n = other.free_list;
+            other.free_list = n->next;
+            n->next = free_list;
+            free_list = n;
+        }
+
+        // the larger unused block is kept for the next allocations
+        if (other.current_end - other.current > current_end - current) {
+            current = other.current;
+            current_end = other.current_end;
+        }
+
+        if (other.next_slab_size > next_slab_size)
+            next_slab_size = other.next_slab_size;
+
+        other.slabs = nullptr;
+        other.current = nullptr;
+        other.current_end = nullptr;
+        other.next_slab_size = min_slab_size;
+    }
+
+    // O(number of slabs): frees all memory at once without destroying the objects
+    void release() {
+        while (slabs) {
+            node *next = slabs[0].next;
+            delete[] slabs;
+            slabs = next;
+        }
+
+        free_list = nullptr;
+        current = nullptr;
+        current_end = nullptr;
+        next_slab_size = min_slab_size;
+    }
+};
+
+}
+
+#endif